@@ -38,6 +38,15 @@ public:
         //if (transform.RotationZ > TWO_PI)[[unlikely]] transform.RotationZ -= TWO_PI;
     }
 
+    // Stamped into every new cube's row by Create
+    static void DefineDefaults(PrefabDefaults& Defaults)
+    {
+        Defaults.Set<Transform<>>("ScaleX", 1.0f);
+        Defaults.Set<Transform<>>("ScaleY", 1.0f);
+        Defaults.Set<Transform<>>("ScaleZ", 1.0f);
+        Defaults.Set<ColorData<>>("A", 1.0f);
+    }
+
     STRIGID_REGISTER_SCHEMA(BaseCube, BaseCubeSuper, transform, color)
 };
 
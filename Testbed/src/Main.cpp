@@ -1,13 +1,20 @@
 #include "Registry.h"
+#include <chrono>
+#include <filesystem>
 #include <iostream>
 #include <random>
+#include <thread>
 
 #include "StrigidEngine.h"
 #include "TestEntity.h"
 #include "CubeEntity.h"
 #include "Archetype.h"
 #include "Logger.h"
+#include "SimulationWorld.h"
+#include "StreamingLoader.h"
 #include "TestFramework.h"
+#include "TimerWheel.h"
+#include "WorldSector.h"
 
 using namespace Strigid::Testing;
 
@@ -67,6 +74,1047 @@ TEST(Registry_DestroyAndReuse)
     Reg->ResetRegistry();
 }
 
+TEST(Registry_DeferredDestroyCompacts)
+{
+    Registry* Reg = Engine.GetRegistry();
+    std::vector<EntityID> Entities;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        Entities.push_back(Reg->Create<TestEntity<>>());
+    }
+
+    Reg->Destroy(Entities[0]);
+    Reg->Destroy(Entities[5]);
+    Reg->Destroy(Entities[5]); // Duplicate destroys are ignored
+    ASSERT_EQ(Reg->GetTotalEntityCount(), 10);
+
+    Reg->FlushCommandBuffers();
+    ASSERT_EQ(Reg->GetTotalEntityCount(), 8);
+
+    Reg->ResetRegistry();
+}
+
+TEST(Registry_DestroyWhereKeepsSurvivors)
+{
+    Registry* Reg = Engine.GetRegistry();
+    const uint32_t PositionX = FieldIndexOf<Transform<>>("PositionX");
+    std::vector<EntityID> Entities;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        Entities.push_back(Reg->Create<TestEntity<>>());
+        *Reg->GetField<Transform<>>(Entities.back(), PositionX) = static_cast<float>(i % 10);
+    }
+
+    const uint32_t Destroyed = Reg->DestroyWhere<Transform>([](auto& T)
+    {
+        return _mm256_movemask_ps(_mm256_cmp_ps(T.PositionX.Load(), _mm256_set1_ps(3.0f), _CMP_LT_OQ));
+    });
+    ASSERT_EQ(Destroyed, 30);
+    ASSERT_EQ(Reg->GetTotalEntityCount(), 70);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        float* X = Reg->GetField<Transform<>>(Entities[i], PositionX);
+        ASSERT_EQ(X != nullptr, i % 10 >= 3);
+        if (X)
+        {
+            ASSERT_EQ(*X, static_cast<float>(i % 10));
+        }
+    }
+
+    Reg->ResetRegistry();
+}
+
+TEST(Registry_CreateDestroyHooksFireOnce)
+{
+    Registry* Reg = Engine.GetRegistry();
+    const uint32_t PositionX = FieldIndexOf<Transform<>>("PositionX");
+    const uint32_t VelocityZ = FieldIndexOf<Velocity<>>("vZ");
+    std::vector<EntityID> Entities;
+
+    // Half created inline, half recorded, neither a multiple of the batch width
+    for (int i = 0; i < 21; ++i)
+    {
+        Entities.push_back(Reg->Create<HookedTestEntity<>>());
+    }
+    for (int i = 0; i < 21; ++i)
+    {
+        Entities.push_back(Reg->GetCommandBuffer().Create<HookedTestEntity<>>());
+    }
+    Reg->FlushCommandBuffers();
+    for (EntityID& Id : Entities)
+    {
+        Id = Reg->ResolveCreated(Id);
+    }
+    ASSERT_EQ(Reg->GetTotalEntityCount(), 42);
+
+    HookedDestroyCounts.assign(Entities.size(), 0);
+    for (size_t i = 0; i < Entities.size(); ++i)
+    {
+        ASSERT_EQ(*Reg->GetField<Velocity<>>(Entities[i], VelocityZ), 1.0f);
+        *Reg->GetField<Transform<>>(Entities[i], PositionX) = static_cast<float>(i);
+    }
+
+    // Every third through the command buffer (recorded twice, destroyed once), the rest of the first 20 by predicate
+    for (size_t i = 0; i < Entities.size(); i += 3)
+    {
+        Reg->Destroy(Entities[i]);
+        Reg->Destroy(Entities[i]);
+    }
+    Reg->FlushCommandBuffers();
+    const uint32_t Destroyed = Reg->DestroyWhere<Transform>([](auto& T)
+    {
+        return _mm256_movemask_ps(_mm256_cmp_ps(T.PositionX.Load(), _mm256_set1_ps(20.0f), _CMP_LT_OQ));
+    });
+    ASSERT_EQ(Destroyed, 13);
+    ASSERT_EQ(Reg->GetTotalEntityCount(), 15);
+
+    for (size_t i = 0; i < Entities.size(); ++i)
+    {
+        ASSERT_EQ(HookedDestroyCounts[i], (i % 3 == 0 || i < 20) ? 1u : 0u);
+    }
+
+    Reg->ResetRegistry();
+}
+
+TEST(Registry_GatherScatterAcrossChunks)
+{
+    Registry* Reg = Engine.GetRegistry();
+    const uint32_t PositionX = FieldIndexOf<Transform<>>("PositionX");
+    const uint32_t PositionZ = FieldIndexOf<Transform<>>("PositionZ");
+    const uint32_t VelocityX = FieldIndexOf<Velocity<>>("vX");
+
+    // Three chunks' worth plus an entity without Velocity and a stale ID
+    std::vector<EntityID> Entities;
+    for (int i = 0; i < 3000; ++i)
+    {
+        Entities.push_back(Reg->Create<TestEntity<>>());
+    }
+    const EntityID Flagged = Reg->Create<FlaggedTestEntity<>>();
+    const EntityID Stale = Entities[5];
+    Reg->Destroy(Stale);
+    Reg->FlushCommandBuffers();
+
+    // Visited out of row order, jumping between chunks
+    std::vector<EntityID> Ids;
+    for (uint32_t i = 0; i < 3000; ++i)
+    {
+        Ids.push_back(Entities[(i * 7) % 3000]);
+    }
+    Ids.push_back(Flagged);
+
+    std::vector<float> X(Ids.size());
+    std::vector<float> Z(Ids.size());
+    for (size_t i = 0; i < Ids.size(); ++i)
+    {
+        X[i] = static_cast<float>(i);
+        Z[i] = -static_cast<float>(i);
+    }
+    std::vector<uint8_t> Valid(Ids.size());
+    const FieldColumn Scattered[] = {{PositionX, X.data()}, {PositionZ, Z.data()}};
+    ASSERT_EQ(Reg->ScatterFields<Transform<>>(Ids, Scattered, Valid.data()), 3000);
+
+    for (size_t i = 0; i < Ids.size(); ++i)
+    {
+        ASSERT_EQ(Valid[i] != 0, Ids[i] != Stale);
+        if (Valid[i])
+        {
+            ASSERT_EQ(*Reg->GetField<Transform<>>(Ids[i], PositionX), X[i]);
+            ASSERT_EQ(*Reg->GetField<Transform<>>(Ids[i], PositionZ), Z[i]);
+        }
+    }
+
+    std::vector<float> GatheredX(Ids.size(), -1.0f);
+    std::vector<float> GatheredZ(Ids.size(), -1.0f);
+    const FieldColumn Gathered[] = {{PositionX, GatheredX.data()}, {PositionZ, GatheredZ.data()}};
+    ASSERT_EQ(Reg->GatherFields<Transform<>>(Ids, Gathered, Valid.data()), 3000);
+
+    for (size_t i = 0; i < Ids.size(); ++i)
+    {
+        ASSERT_EQ(Valid[i] != 0, Ids[i] != Stale);
+        if (Valid[i])
+        {
+            ASSERT_EQ(GatheredX[i], X[i]);
+            ASSERT_EQ(GatheredZ[i], Z[i]);
+        }
+    }
+
+    // Entities without the component are skipped like stale IDs
+    std::vector<float> VX(Ids.size());
+    const FieldColumn Velocities[] = {{VelocityX, VX.data()}};
+    ASSERT_EQ(Reg->GatherFields<Velocity<>>(Ids, Velocities, Valid.data()), 2999);
+    ASSERT_EQ(Valid.back(), 0);
+
+    Reg->ResetRegistry();
+}
+
+TEST(Registry_BlockedLayoutRoundTrips)
+{
+    Registry* Reg = Engine.GetRegistry();
+    const uint32_t PositionX = FieldIndexOf<Transform<>>("PositionX");
+    const uint32_t VelocityX = FieldIndexOf<Velocity<>>("vX");
+    std::vector<EntityID> Entities;
+
+    // Not a multiple of the block width, so the last block is partial
+    for (int i = 0; i < 37; ++i)
+    {
+        Entities.push_back(Reg->Create<BlockedTestEntity<>>());
+        *Reg->GetField<Transform<>>(Entities.back(), PositionX) = static_cast<float>(i);
+        *Reg->GetField<Velocity<>>(Entities.back(), VelocityX) = 0.0f;
+    }
+
+    Reg->ForEach<Transform>([](auto& T) { T.PositionX += 1.0f; });
+    Reg->InvokeUpdate(0.0);
+
+    // Rows 0-8 go, the survivors shift across block boundaries
+    const uint32_t Destroyed = Reg->DestroyWhere<Transform>([](auto& T)
+    {
+        return _mm256_movemask_ps(_mm256_cmp_ps(T.PositionX.Load(), _mm256_set1_ps(10.0f), _CMP_LT_OQ));
+    });
+    ASSERT_EQ(Destroyed, 9);
+
+    for (int i = 9; i < 37; ++i)
+    {
+        ASSERT_EQ(*Reg->GetField<Transform<>>(Entities[i], PositionX), static_cast<float>(i + 1));
+        ASSERT_EQ(*Reg->GetField<Velocity<>>(Entities[i], VelocityX), 1.0f);
+    }
+
+    Reg->ResetRegistry();
+}
+
+TEST(Registry_BitFieldsFilterRows)
+{
+    Registry* Reg = Engine.GetRegistry();
+    const uint32_t PositionX = FieldIndexOf<Transform<>>("PositionX");
+    const uint32_t State = FieldIndexOf<TestFlags<>>("State");
+    std::vector<EntityID> Entities;
+
+    // Odd rows are alive, teams cycle 0-3
+    for (int i = 0; i < 37; ++i)
+    {
+        Entities.push_back(Reg->Create<FlaggedTestEntity<>>());
+        *Reg->GetField<Transform<>>(Entities.back(), PositionX) = 0.0f;
+        *Reg->GetField<TestFlags<>, uint8_t>(Entities.back(), State) = static_cast<uint8_t>((i % 2) | ((i % 4) << 2));
+    }
+
+    Reg->ForEach<Transform, TestFlags>([](auto& T, auto& F)
+    {
+        T.PositionX.StoreWhere(F.Alive().Mask(), _mm256_set1_ps(-1.0f));
+        F.Team().Store(F.Team().Equals(3), 1);
+    });
+
+    const uint32_t Destroyed = Reg->DestroyWhere<TestFlags>([](auto& F) { return ~F.Alive().Mask(); });
+    ASSERT_EQ(Destroyed, 19);
+
+    for (int i = 1; i < 37; i += 2)
+    {
+        ASSERT_EQ(*Reg->GetField<Transform<>>(Entities[i], PositionX), -1.0f);
+        const uint8_t* Flags = Reg->GetField<TestFlags<>, uint8_t>(Entities[i], State);
+        ASSERT_EQ(*Flags, static_cast<uint8_t>(1 | ((i % 4 == 3 ? 1 : i % 4) << 2)));
+    }
+
+    Reg->ResetRegistry();
+}
+
+TEST(Registry_RebaseWorldSectors)
+{
+    Registry* Reg = Engine.GetRegistry();
+    const uint32_t PositionX = FieldIndexOf<Transform<>>("PositionX");
+    const uint32_t PositionY = FieldIndexOf<Transform<>>("PositionY");
+    const uint32_t PositionZ = FieldIndexOf<Transform<>>("PositionZ");
+
+    EntityID Near = Reg->Create<TestEntity<>>();
+    EntityID Far = Reg->Create<TestEntity<>>();
+    for (EntityID Id : {Near, Far})
+    {
+        Reg->SetShared(Id, WorldSector{97, 0, -3});
+    }
+    Reg->FlushCommandBuffers();
+
+    for (EntityID Id : {Near, Far})
+    {
+        *Reg->GetField<Transform<>>(Id, PositionX) = 100.0f;
+        *Reg->GetField<Transform<>>(Id, PositionY) = 0.0f;
+        *Reg->GetField<Transform<>>(Id, PositionZ) = 0.0f;
+    }
+    *Reg->GetField<Transform<>>(Far, PositionX) = 600.0f;
+    *Reg->GetField<Transform<>>(Far, PositionZ) = -1700.0f;
+
+    ASSERT_EQ(RebaseWorldSectors(*Reg), 1);
+    ASSERT_EQ(Reg->GetShared<WorldSector>(Near)->X, 97);
+    ASSERT_EQ(Reg->GetShared<WorldSector>(Far)->X, 98);
+    ASSERT_EQ(Reg->GetShared<WorldSector>(Far)->Z, -5);
+    ASSERT_EQ(*Reg->GetField<Transform<>>(Near, PositionX), 100.0f);
+    ASSERT_EQ(*Reg->GetField<Transform<>>(Far, PositionX), -424.0f);
+    ASSERT_EQ(*Reg->GetField<Transform<>>(Far, PositionZ), 348.0f);
+    ASSERT_EQ(RebaseWorldSectors(*Reg), 0);
+
+    Reg->ResetRegistry();
+}
+
+TEST(Registry_StagedRegionJoinsAtSyncPoint)
+{
+    Registry* Reg = Engine.GetRegistry();
+    const ComponentTypeID TransformID = GetComponentTypeID<Transform<>>();
+    const ComponentTypeID VelocityID = GetComponentTypeID<Velocity<>>();
+    const uint32_t PositionX = FieldIndexOf<Transform<>>("PositionX");
+    const uint32_t VelocityX = FieldIndexOf<Velocity<>>("vX");
+    const std::string Path = "StrigidRegionTest.bin";
+
+    // Two classes, one of them spanning more than a chunk
+    std::vector<EntityID> Entities;
+    for (int i = 0; i < 1500; ++i)
+    {
+        Entities.push_back(Reg->Create<TestEntity<>>());
+        *Reg->GetField<Transform<>>(Entities.back(), PositionX) = static_cast<float>(i);
+        *Reg->GetField<Velocity<>>(Entities.back(), VelocityX) = static_cast<float>(2 * i);
+    }
+    for (int i = 1500; i < 1510; ++i)
+    {
+        Entities.push_back(Reg->Create<CubeEntity<>>());
+        *Reg->GetField<Transform<>>(Entities.back(), PositionX) = static_cast<float>(i);
+    }
+    ASSERT(Reg->SaveRegion(Entities, Path));
+    Reg->ResetRegistry();
+
+    {
+        StreamingLoader Loader(*Reg);
+        Loader.Request(Path);
+        Loader.WaitIdle();
+        ASSERT_EQ(Loader.GetQueuedCount(), 0);
+    }
+    std::filesystem::remove(Path);
+
+    // Staged rows join the archetypes at the sync point
+    ASSERT_EQ(Reg->GetTotalEntityCount(), 0);
+    Reg->FlushCommandBuffers();
+    ASSERT_EQ(Reg->GetTotalEntityCount(), 1510);
+
+    std::vector<uint8_t> Seen(1510, 0);
+    for (Archetype* Arch : Reg->ComponentQuery<Transform<>>())
+    {
+        if (!Arch)
+            break;
+
+        const bool bHasVelocity = Arch->GetFieldTableIndex(VelocityID) >= 0;
+        for (size_t ChunkIdx = 0; ChunkIdx < Arch->Chunks.size(); ++ChunkIdx)
+        {
+            Chunk* Staged = Arch->Chunks[ChunkIdx];
+            const float* X = static_cast<float*>(Arch->GetFieldArray(Staged, TransformID, PositionX));
+            const float* VX = bHasVelocity
+                                  ? static_cast<float*>(Arch->GetFieldArray(Staged, VelocityID, VelocityX))
+                                  : nullptr;
+            for (uint32_t i = 0; i < Arch->GetChunkCount(ChunkIdx); ++i)
+            {
+                const uint32_t Row = static_cast<uint32_t>(X[i]);
+                ASSERT(Row < 1510 && !Seen[Row]);
+                ASSERT_EQ(bHasVelocity, Row < 1500);
+                if (VX)
+                {
+                    ASSERT_EQ(VX[i], static_cast<float>(2 * Row));
+                }
+                Seen[Row] = 1;
+            }
+        }
+    }
+    ASSERT(std::find(Seen.begin(), Seen.end(), 0) == Seen.end());
+
+    Reg->ResetRegistry();
+}
+
+TEST(Registry_SparseComponentsJoinArchetypes)
+{
+    Registry* Reg = Engine.GetRegistry();
+    const uint32_t PositionX = FieldIndexOf<Transform<>>("PositionX");
+    std::vector<EntityID> Entities;
+
+    // Even entities get a buff
+    for (int i = 0; i < 20; ++i)
+    {
+        Entities.push_back(Reg->Create<TestEntity<>>());
+        *Reg->GetField<Transform<>>(Entities.back(), PositionX) = static_cast<float>(i);
+        if (i % 2 == 0)
+        {
+            Reg->AddSparse<TestBuff>(Entities.back())->Source = static_cast<uint32_t>(i);
+        }
+    }
+    ASSERT_EQ(Reg->AddSparse<TestBuff>(Entities[4])->Source, 4);
+    ASSERT(Reg->GetSparse<TestBuff>(Entities[1]) == nullptr);
+
+    // The first and a middle element go, the last ones are swapped into their holes
+    ASSERT(Reg->RemoveSparse<TestBuff>(Entities[0]));
+    ASSERT(Reg->RemoveSparse<TestBuff>(Entities[10]));
+    ASSERT(!Reg->RemoveSparse<TestBuff>(Entities[10]));
+    ASSERT(Reg->GetSparse<TestBuff>(Entities[0]) == nullptr);
+    ASSERT_EQ(Reg->GetSparse<TestBuff>(Entities[18])->Source, 18);
+    ASSERT_EQ(Reg->GetSparse<TestBuff>(Entities[16])->Source, 16);
+
+    // Destroyed entities drop their value too
+    Reg->Destroy(Entities[2]);
+    Reg->FlushCommandBuffers();
+
+    std::vector<uint32_t> Visited;
+    Reg->ForEachSparse<TestBuff, Transform>([&Visited](TestBuff& Buff, auto& T)
+    {
+        Visited.push_back(Buff.Source);
+        T.PositionX = static_cast<float>(Buff.Source + 100);
+    });
+    std::sort(Visited.begin(), Visited.end());
+    ASSERT(Visited == std::vector<uint32_t>({4, 6, 8, 12, 14, 16, 18}));
+
+    for (int i = 3; i < 20; ++i)
+    {
+        const bool bBuffed = i % 2 == 0 && i != 10;
+        ASSERT_EQ(*Reg->GetField<Transform<>>(Entities[i], PositionX), static_cast<float>(bBuffed ? i + 100 : i));
+    }
+
+    // Re-adding starts from a zeroed value
+    ASSERT_EQ(Reg->AddSparse<TestBuff>(Entities[10])->Source, 0);
+
+    Reg->ResetRegistry();
+}
+
+TEST(Registry_TagsMoveEntitiesWithoutStorage)
+{
+    Registry* Reg = Engine.GetRegistry();
+    const uint32_t PositionX = FieldIndexOf<Transform<>>("PositionX");
+    const uint32_t ScaleX = FieldIndexOf<Transform<>>("ScaleX");
+    const uint32_t VelocityX = FieldIndexOf<Velocity<>>("vX");
+    std::vector<EntityID> Entities;
+
+    // Even entities get the tag
+    for (int i = 0; i < 20; ++i)
+    {
+        Entities.push_back(Reg->Create<TestEntity<>>());
+        *Reg->GetField<Transform<>>(Entities.back(), PositionX) = static_cast<float>(i);
+        *Reg->GetField<Transform<>>(Entities.back(), ScaleX) = 1.0f;
+        *Reg->GetField<Velocity<>>(Entities.back(), VelocityX) = static_cast<float>(2 * i);
+        if (i % 2 == 0)
+        {
+            Reg->AddComponent<TestMarked<>>(Entities.back());
+        }
+    }
+    Reg->FlushCommandBuffers();
+
+    // The tagged archetype has the same field arrays and row capacity as the untagged one
+    const std::vector<Archetype*> TaggedArchs = Reg->ComponentQuery<Transform<>, Velocity<>, TestMarked<>>();
+    Archetype* Plain = nullptr;
+    Archetype* Marked = nullptr;
+    for (Archetype* Arch : Reg->ComponentQuery<Transform<>, Velocity<>>())
+    {
+        if (!Arch)
+            break;
+        if (Arch->TotalEntityCount == 0)
+            continue;
+
+        const bool bTagged = std::find(TaggedArchs.begin(), TaggedArchs.end(), Arch) != TaggedArchs.end();
+        ASSERT((bTagged ? Marked : Plain) == nullptr);
+        (bTagged ? Marked : Plain) = Arch;
+    }
+    ASSERT(Plain && Marked);
+    ASSERT_EQ(Plain->TotalEntityCount, 10);
+    ASSERT_EQ(Marked->TotalEntityCount, 10);
+    ASSERT_EQ(Marked->FieldArrayTemplateCache.size(), Plain->FieldArrayTemplateCache.size());
+    ASSERT_EQ(Marked->EntitiesPerChunk, Plain->EntitiesPerChunk);
+
+    Reg->ForEach<Transform, TestMarked>([](auto& T, auto&) { T.ScaleX = 2.0f; });
+    Reg->RemoveComponent<TestMarked<>>(Entities[0]);
+    Reg->FlushCommandBuffers();
+
+    // Moving in and out of the tagged archetype keeps the field data
+    for (int i = 0; i < 20; ++i)
+    {
+        ASSERT_EQ(Reg->HasComponent<TestMarked<>>(Entities[i]), i % 2 == 0 && i != 0);
+        ASSERT_EQ(*Reg->GetField<Transform<>>(Entities[i], PositionX), static_cast<float>(i));
+        ASSERT_EQ(*Reg->GetField<Transform<>>(Entities[i], ScaleX), i % 2 == 0 ? 2.0f : 1.0f);
+        ASSERT_EQ(*Reg->GetField<Velocity<>>(Entities[i], VelocityX), static_cast<float>(2 * i));
+    }
+    ASSERT_EQ(Reg->GetTotalEntityCount(), 20);
+
+    Reg->ResetRegistry();
+}
+
+TEST(Registry_ConcurrentCreate)
+{
+    Registry* Reg = Engine.GetRegistry();
+    std::vector<EntityID> Entities(400);
+
+    std::vector<std::thread> Producers;
+    for (int t = 0; t < 4; ++t)
+    {
+        Producers.emplace_back([Reg, &Entities, t]()
+        {
+            Reg->CreateConcurrent<TestEntity<>>(100, &Entities[t * 100]);
+        });
+    }
+    for (std::thread& Producer : Producers)
+    {
+        Producer.join();
+    }
+
+    // Staged rows join the archetype at the sync point
+    ASSERT_EQ(Reg->GetTotalEntityCount(), 0);
+    Reg->FlushCommandBuffers();
+    ASSERT_EQ(Reg->GetTotalEntityCount(), 400);
+
+    for (EntityID Id : Entities)
+    {
+        ASSERT(Reg->HasComponent<Transform<>>(Id));
+    }
+
+    Reg->ResetRegistry();
+}
+
+TEST(Registry_ConcurrentCreateLimits)
+{
+    Registry* Reg = Engine.GetRegistry();
+    const EntityID First = Reg->Create<TestEntity<>>();
+
+    Archetype* Arch = nullptr;
+    for (Archetype* Candidate : Reg->ComponentQuery<Transform<>, Velocity<>>())
+    {
+        if (!Candidate)
+            break;
+        if (Candidate->TotalEntityCount > 0)
+            Arch = Candidate;
+    }
+    ASSERT(Arch);
+    const uint32_t RowLimit = Archetype::MAX_PENDING_CHUNKS * Arch->EntitiesPerChunk;
+    std::vector<EntityID> Ids(RowLimit + 1);
+
+    // Failed reservations take neither indices nor pending rows (nothing is written to Ids either)
+    ASSERT_EQ(Reg->CreateConcurrent<TestEntity<>>(EntityIndexTable::MAX_INDEX, Ids.data()), 0);
+    ASSERT_EQ(Reg->CreateConcurrent<TestEntity<>>(RowLimit + 1, Ids.data()), 0);
+    ASSERT_EQ(Reg->CreateConcurrent<TestEntity<>>(RowLimit - 1, Ids.data()), RowLimit - 1);
+    ASSERT_EQ(Reg->CreateConcurrent<TestEntity<>>(2, &Ids[RowLimit - 1]), 0);
+    ASSERT_EQ(Reg->CreateConcurrent<TestEntity<>>(1, &Ids[RowLimit - 1]), 1);
+    ASSERT_EQ(Arch->GetPendingCount(), RowLimit);
+
+    Reg->FlushCommandBuffers();
+    ASSERT_EQ(Reg->GetTotalEntityCount(), RowLimit + 1);
+    for (uint32_t i = 0; i < RowLimit; ++i)
+    {
+        ASSERT_EQ(Ids[i].GetIndex(), First.GetIndex() + 1 + i);
+        ASSERT(Reg->IsActive(Ids[i]));
+    }
+
+    Reg->ResetRegistry();
+}
+
+TEST(Registry_ThreadsRecordCommands)
+{
+    Registry* Reg = Engine.GetRegistry();
+    std::vector<EntityID> Entities;
+    for (int i = 0; i < 400; ++i)
+    {
+        Entities.push_back(Reg->Create<TestEntity<>>());
+    }
+
+    // Non-worker threads each get their own command buffer
+    std::vector<std::thread> Recorders;
+    for (int t = 0; t < 4; ++t)
+    {
+        Recorders.emplace_back([Reg, &Entities, t]()
+        {
+            for (int i = t; i < 400; i += 8)
+            {
+                Reg->Destroy(Entities[i]);
+            }
+        });
+    }
+    for (std::thread& Recorder : Recorders)
+    {
+        Recorder.join();
+    }
+
+    Reg->FlushCommandBuffers();
+    ASSERT_EQ(Reg->GetTotalEntityCount(), 200);
+    for (int i = 0; i < 400; ++i)
+    {
+        ASSERT_EQ(Reg->IsActive(Entities[i]), i % 8 >= 4);
+    }
+
+    Reg->ResetRegistry();
+}
+
+TEST(Registry_DeferredCreatesReuseIndices)
+{
+    Registry* Reg = Engine.GetRegistry();
+    uint32_t MaxIndex = 0;
+
+    for (int Round = 0; Round < 10; ++Round)
+    {
+        std::vector<EntityID> Pending;
+        for (int i = 0; i < 100; ++i)
+        {
+            Pending.push_back(Reg->GetCommandBuffer().Create<TestEntity<>>());
+            if (i % 2 == 0)
+            {
+                // Later commands can target the pending ID
+                Reg->GetCommandBuffer().AddComponent<TestMarked<>>(Pending.back());
+            }
+        }
+        ASSERT(!Reg->IsActive(Pending[0]));
+        ASSERT(!Reg->ResolveCreated(Pending[0]).IsValid());
+        Reg->FlushCommandBuffers();
+
+        for (int i = 0; i < 100; ++i)
+        {
+            const EntityID Id = Reg->ResolveCreated(Pending[i]);
+            ASSERT(Reg->IsActive(Id));
+            ASSERT_EQ(Reg->HasComponent<TestMarked<>>(Id), i % 2 == 0);
+            MaxIndex = std::max(MaxIndex, Id.GetIndex());
+            Reg->Destroy(Id);
+        }
+        Reg->FlushCommandBuffers();
+    }
+
+    // Destroyed indices are handed out again instead of growing the table
+    ASSERT(MaxIndex <= 100);
+    ASSERT_EQ(Reg->GetTotalEntityCount(), 0);
+
+    Reg->ResetRegistry();
+}
+
+TEST(Registry_ForEachVisitsEveryRow)
+{
+    Registry* Reg = Engine.GetRegistry();
+    std::vector<EntityID> Entities;
+
+    // Not a multiple of the batch width, so the masked tail runs too
+    for (int i = 0; i < 21; ++i)
+    {
+        Entities.push_back(Reg->Create<TestEntity<>>());
+    }
+
+    Reg->ForEach<Transform>([](auto& T) { T.ScaleX = 2.0f; });
+    Reg->ParallelForEach<Transform, Velocity>([](auto& T, auto&) { T.ScaleX *= 2.0f; });
+
+    uint32_t Visited = 0;
+    for (Archetype* Arch : Reg->ComponentQuery<Transform<>>())
+    {
+        if (!Arch)
+            break;
+
+        for (size_t ChunkIdx = 0; ChunkIdx < Arch->Chunks.size(); ++ChunkIdx)
+        {
+            const float* ScaleX = static_cast<float*>(Arch->GetFieldArray(Arch->Chunks[ChunkIdx],
+                                                                          GetComponentTypeID<Transform<>>(), 6));
+            for (uint32_t i = 0; i < Arch->GetChunkCount(ChunkIdx); ++i)
+            {
+                ASSERT_EQ(ScaleX[i], 4.0f);
+                ++Visited;
+            }
+        }
+    }
+    ASSERT_EQ(Visited, Entities.size());
+
+    Reg->ResetRegistry();
+}
+
+TEST(Registry_CreateStampsDefaults)
+{
+    Registry* Reg = Engine.GetRegistry();
+    std::vector<EntityID> Entities(40);
+
+    Entities[0] = Reg->Create<CubeEntity<>>();
+    ASSERT_EQ(Reg->CreateBatch<CubeEntity<>>(39, &Entities[1]), 39);
+
+    for (EntityID Id : Entities)
+    {
+        ASSERT_EQ(*Reg->GetField<Transform<>>(Id, FieldIndexOf<Transform<>>("ScaleY")), 1.0f);
+        ASSERT_EQ(*Reg->GetField<ColorData<>>(Id, FieldIndexOf<ColorData<>>("A")), 1.0f);
+        ASSERT_EQ(*Reg->GetField<Transform<>>(Id, FieldIndexOf<Transform<>>("PositionX")), 0.0f);
+    }
+
+    Reg->ResetRegistry();
+}
+
+TEST(Registry_DormantEntitiesSkipped)
+{
+    Registry* Reg = Engine.GetRegistry();
+    std::vector<EntityID> Entities;
+    for (int i = 0; i < 20; ++i)
+    {
+        Entities.push_back(Reg->Create<TestEntity<>>());
+    }
+
+    for (int i = 0; i < 20; i += 4)
+    {
+        Reg->Deactivate(Entities[i]);
+    }
+    Reg->FlushCommandBuffers();
+    ASSERT(!Reg->IsActive(Entities[0]));
+    ASSERT(Reg->IsActive(Entities[1]));
+
+    // The body runs per batch, so mark rows and count the marks instead of the calls
+    const uint32_t ScaleX = FieldIndexOf<Transform<>>("ScaleX");
+    for (EntityID Id : Entities)
+    {
+        *Reg->GetField<Transform<>>(Id, ScaleX) = 1.0f;
+    }
+    Reg->ForEach<Transform>([](auto& T) { T.ScaleX = 2.0f; });
+
+    uint32_t Visited = 0;
+    for (int i = 0; i < 20; ++i)
+    {
+        const float Mark = *Reg->GetField<Transform<>>(Entities[i], ScaleX);
+        ASSERT_EQ(Mark, i % 4 == 0 ? 1.0f : 2.0f);
+        Visited += Mark == 2.0f;
+    }
+    ASSERT_EQ(Visited, 15);
+
+    Reg->Activate(Entities[0]);
+    Reg->FlushCommandBuffers();
+    ASSERT(Reg->IsActive(Entities[0]));
+    ASSERT_EQ(Reg->GetTotalEntityCount(), 20);
+
+    Reg->ResetRegistry();
+}
+
+TEST(Registry_TransientRingsExpire)
+{
+    Registry* Reg = Engine.GetRegistry();
+    const uint32_t PositionX = FieldIndexOf<Transform<>>("PositionX");
+    constexpr uint32_t Lifetime = TransientTestEntity<>::TransientLifetime;
+
+    // More rows per tick than a chunk holds and more ticks than the lifetime, so the ring wraps through its spares
+    constexpr uint32_t PerTick = 1500;
+    std::vector<std::vector<EntityID>> Spawned;
+    for (uint32_t Tick = 0; Tick < 8; ++Tick)
+    {
+        std::vector<EntityID>& Ids = Spawned.emplace_back(PerTick);
+        ASSERT_EQ(Reg->SpawnTransient<TransientTestEntity<>>(PerTick, Ids.data()), PerTick);
+        for (uint32_t i = 0; i < PerTick; ++i)
+        {
+            *Reg->GetField<Transform<>>(Ids[i], PositionX) = static_cast<float>(Tick * PerTick + i);
+        }
+        Reg->InvokePostPhys();
+
+        for (uint32_t Born = 0; Born <= Tick; ++Born)
+        {
+            const bool bLive = Tick - Born < Lifetime;
+            for (uint32_t i = 0; i < PerTick; ++i)
+            {
+                const float* X = Reg->GetField<Transform<>>(Spawned[Born][i], PositionX);
+                ASSERT_EQ(X != nullptr, bLive);
+                if (X)
+                {
+                    ASSERT_EQ(*X, static_cast<float>(Born * PerTick + i));
+                }
+            }
+        }
+        ASSERT_EQ(Reg->GetTotalEntityCount(), std::min(Tick + 1, Lifetime) * PerTick);
+    }
+
+    Reg->ResetRegistry();
+}
+
+TEST(TimerWheel_FiresOnDueTick)
+{
+    TimerWheel Wheel;
+    Wheel.Insert(EntityID::Invalid(), 3, 0, 3);
+    Wheel.Insert(EntityID::Invalid(), 300, 0, 300);
+    Wheel.Insert(EntityID::Invalid(), 70000, 0, 70000);
+    TimerHandle Cancelled = Wheel.Insert(EntityID::Invalid(), 5, 0, 5);
+    ASSERT(Wheel.Cancel(Cancelled));
+    ASSERT(!Wheel.Cancel(Cancelled));
+
+    std::vector<TimerExpiry> Expired;
+    while (Wheel.GetPendingCount() > 0)
+    {
+        Expired.clear();
+        Wheel.Advance(Expired);
+        for (const TimerExpiry& Expiry : Expired)
+        {
+            ASSERT_EQ(Expiry.Payload, Wheel.GetTick());
+        }
+    }
+    ASSERT_EQ(Wheel.GetTick(), 70000);
+}
+
+static Behavior CountTicks(uint32_t* Counter)
+{
+    for (;;)
+    {
+        co_await WaitTicks{2};
+        ++*Counter;
+    }
+}
+
+TEST(Registry_BehaviorsResumeWhenDue)
+{
+    Registry* Reg = Engine.GetRegistry();
+    EntityID Id = Reg->Create<TestEntity<>>();
+
+    uint32_t Counter = 0;
+    Reg->StartBehavior(Id, CountTicks(&Counter));
+    for (int i = 0; i < 6; ++i)
+    {
+        Reg->InvokePrePhys();
+        Reg->InvokePostPhys();
+    }
+    ASSERT_EQ(Counter, 3);
+
+    // Destroying the entity ends its behaviors
+    Reg->Destroy(Id);
+    Reg->FlushCommandBuffers();
+    ASSERT_EQ(Reg->GetBehaviorCount(), 0);
+
+    Reg->ResetRegistry();
+}
+
+TEST(SimulationWorld_ValueIndexTracksWrites)
+{
+    EngineConfig WorldConfig;
+    WorldConfig.MaxDynamicEntities = 64;
+    WorldConfig.HistoryBufferPages = 8;
+    SimulationWorld World(WorldConfig);
+    Registry& Reg = World.GetRegistry();
+
+    const uint32_t PositionX = FieldIndexOf<Transform<>>("PositionX");
+    std::vector<EntityID> Entities;
+    for (int i = 0; i < 32; ++i)
+    {
+        Entities.push_back(Reg.Create<TestEntity<>>());
+        *Reg.GetField<Transform<>>(Entities.back(), PositionX) = static_cast<float>(i);
+    }
+
+    const uint32_t Index = Reg.CreateIndex<Transform<>>(PositionX);
+    std::vector<EntityID> Hits;
+    ASSERT_EQ(Reg.QueryIndexRange(Index, 0.0, 9.0, Hits), 10);
+
+    *Reg.GetField<Transform<>>(Entities[20], PositionX) = 5.0f;
+    Reg.Destroy(Entities[3]);
+    Reg.FlushCommandBuffers();
+    Reg.UpdateIndexes();
+
+    Hits.clear();
+    ASSERT_EQ(Reg.QueryIndexRange(Index, 0.0, 9.0, Hits), 10);
+    Hits.clear();
+    ASSERT_EQ(Reg.QueryIndexEqual(Index, 5.0, Hits), 2);
+}
+
+TEST(SimulationWorld_StateChecksumMatches)
+{
+    EngineConfig WorldConfig;
+    WorldConfig.MaxDynamicEntities = 64;
+    WorldConfig.HistoryBufferPages = 8;
+    SimulationWorld WorldA(WorldConfig);
+    SimulationWorld WorldB(WorldConfig);
+
+    const uint32_t PositionX = FieldIndexOf<Transform<>>("PositionX");
+    EntityID Last;
+    for (Registry* Reg : {&WorldA.GetRegistry(), &WorldB.GetRegistry()})
+    {
+        for (int i = 0; i < 40; ++i)
+        {
+            Last = Reg->Create<TestEntity<>>();
+            *Reg->GetField<Transform<>>(Last, PositionX) = static_cast<float>(i);
+        }
+    }
+
+    const uint64_t Checksum = WorldA.GetRegistry().ComputeStateChecksum();
+    ASSERT_EQ(WorldB.GetRegistry().ComputeStateChecksum(), Checksum);
+
+    *WorldB.GetRegistry().GetField<Transform<>>(Last, PositionX) += 1.0f;
+    ASSERT(WorldB.GetRegistry().ComputeStateChecksum() != Checksum);
+}
+
+TEST(SimulationWorld_ChecksumIgnoresWorkerCount)
+{
+    EngineConfig WorldConfig;
+    WorldConfig.MaxDynamicEntities = 64;
+    WorldConfig.HistoryBufferPages = 8;
+
+    const uint32_t PositionX = FieldIndexOf<Transform<>>("PositionX");
+    const uint32_t OriginalWorkers = JobSystem::Get().GetWorkerCount();
+    EngineConfig JobConfig;
+    uint64_t Checksums[2] = {};
+    size_t EntityCounts[2] = {};
+
+    // The same ticks inline, then spread over workers that record their creates in whatever order they run
+    for (int Run = 0; Run < 2; ++Run)
+    {
+        JobConfig.WorkerThreadCount = Run == 0 ? 0 : 4;
+        JobSystem::Get().Initialize(&JobConfig);
+
+        SimulationWorld World(WorldConfig);
+        Registry& Reg = World.GetRegistry();
+        for (int i = 0; i < 3000; ++i)
+        {
+            const EntityID Id = Reg.Create<SpawnerTestEntity<>>();
+            *Reg.GetField<Transform<>>(Id, PositionX) = static_cast<float>(i);
+        }
+        while (World.GetFixedStepCount() < 5)
+        {
+            World.Advance(WorldConfig.GetFixedStepTime());
+        }
+
+        Checksums[Run] = Reg.ComputeStateChecksum();
+        EntityCounts[Run] = Reg.GetTotalEntityCount();
+    }
+
+    JobConfig.WorkerThreadCount = static_cast<int>(OriginalWorkers);
+    JobSystem::Get().Initialize(&JobConfig);
+
+    ASSERT(EntityCounts[0] > 3000);
+    ASSERT_EQ(EntityCounts[1], EntityCounts[0]);
+    ASSERT_EQ(Checksums[1], Checksums[0]);
+}
+
+TEST(SimulationWorld_IsolatedStorage)
+{
+    EngineConfig WorldConfig;
+    WorldConfig.MaxDynamicEntities = 64;
+    WorldConfig.HistoryBufferPages = 8;
+
+    SimulationWorld WorldA(WorldConfig);
+    SimulationWorld WorldB(WorldConfig);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        WorldA.GetRegistry().Create<TestEntity<>>();
+    }
+    WorldB.GetRegistry().Create<TestEntity<>>();
+
+    ASSERT_EQ(WorldA.GetRegistry().GetTotalEntityCount(), 10);
+    ASSERT_EQ(WorldB.GetRegistry().GetTotalEntityCount(), 1);
+
+    SimulationWorld* Worlds[] = {&WorldA, &WorldB};
+    SimulationWorld::StepAll(Worlds, 2, WorldConfig.GetFixedStepTime());
+
+    ASSERT_EQ(WorldA.GetFixedStepCount(), 1);
+    ASSERT_EQ(WorldB.GetFixedStepCount(), 1);
+}
+
+TEST(SimulationWorld_MergedClassesShareChunks)
+{
+    EngineConfig WorldConfig;
+    WorldConfig.MaxDynamicEntities = 64;
+    WorldConfig.HistoryBufferPages = 8;
+    WorldConfig.bMergeSameSignatureClasses = true;
+
+    SimulationWorld World(WorldConfig);
+    Registry& Reg = World.GetRegistry();
+
+    // Same components and defaults, interleaved so the rows have to be sorted into class runs
+    for (int i = 0; i < 10; ++i)
+    {
+        Reg.Create<CubeEntity<>>();
+        Reg.Create<SuperCube<>>();
+    }
+    ASSERT_EQ(Reg.GetTotalChunkCount(), 1);
+
+    SimulationWorld* Worlds[] = {&World};
+    SimulationWorld::StepAll(Worlds, 1, WorldConfig.GetFixedStepTime());
+    ASSERT_EQ(Reg.GetTotalEntityCount(), 20);
+}
+
+TEST(SimulationWorld_DormantChunksPageOut)
+{
+    EngineConfig WorldConfig;
+    WorldConfig.MaxDynamicEntities = 64;
+    WorldConfig.HistoryBufferPages = 8;
+    WorldConfig.DormantChunkPageOutSeconds = 1;
+
+    SimulationWorld World(WorldConfig);
+    Registry& Reg = World.GetRegistry();
+    const uint32_t PositionX = FieldIndexOf<Transform<>>("PositionX");
+    const uint32_t VelocityX = FieldIndexOf<Velocity<>>("vX");
+
+    // A few chunks' worth, every chunk but the tail can page out
+    std::vector<EntityID> Entities;
+    for (int i = 0; i < 3000; ++i)
+    {
+        Entities.push_back(Reg.Create<TestEntity<>>());
+        *Reg.GetField<Transform<>>(Entities.back(), PositionX) = static_cast<float>(i);
+        *Reg.GetField<Velocity<>>(Entities.back(), VelocityX) = 0.0f;
+    }
+    for (EntityID Id : Entities)
+    {
+        Reg.Deactivate(Id);
+    }
+    Reg.FlushCommandBuffers();
+    ASSERT_EQ(Reg.GetPagedChunkCount(), 0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    Reg.FlushCommandBuffers();
+    const uint32_t Paged = Reg.GetPagedChunkCount();
+    ASSERT(Paged > 0);
+    ASSERT_EQ(Reg.GetTotalEntityCount(), 3000);
+
+    // Touching a row pages its chunk back in
+    ASSERT_EQ(*Reg.GetField<Transform<>>(Entities[0], PositionX), 0.0f);
+    ASSERT_EQ(Reg.GetPagedChunkCount(), Paged - 1);
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        ASSERT(!Reg.IsActive(Entities[i]));
+        ASSERT_EQ(*Reg.GetField<Transform<>>(Entities[i], PositionX), static_cast<float>(i));
+        ASSERT_EQ(*Reg.GetField<Velocity<>>(Entities[i], VelocityX), 0.0f);
+    }
+    ASSERT_EQ(Reg.GetPagedChunkCount(), 0);
+}
+
+TEST(ChunkPager_ReusesFreedRanges)
+{
+    const std::string Path = "StrigidPagerTest.bin";
+    ChunkPager Pager;
+    ASSERT(Pager.Open(Path));
+
+    // The writer is asynchronous, pages are on disk once the file has grown to hold them
+    auto WaitForFileSize = [&Path](uint64_t Size)
+    {
+        const auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (std::filesystem::file_size(Path) < Size && std::chrono::steady_clock::now() < Deadline)
+        {
+            std::this_thread::yield();
+        }
+        return std::filesystem::file_size(Path) == Size;
+    };
+
+    // A zero run longer than one token holds, a literal run with a short zero gap, trailing zeros
+    std::vector<uint8_t> Sparse(200000, 0);
+    for (uint32_t i = 70000; i < 70100; ++i)
+    {
+        Sparse[i] = static_cast<uint8_t>(i | 1);
+    }
+    Sparse[70102] = 7;
+    Sparse[150000] = 1;
+    const std::vector<uint8_t> Dense(1000, 0xAB);
+
+    const uint32_t SparseHandle = Pager.Write(Sparse);
+    const uint64_t SparseBytes = Pager.GetCompressedBytes();
+    ASSERT(SparseBytes < 200);
+    const uint32_t DenseHandle = Pager.Write(Dense);
+    const uint64_t DenseBytes = Pager.GetCompressedBytes() - SparseBytes;
+    ASSERT_EQ(Pager.GetPageCount(), 2);
+    ASSERT(WaitForFileSize(SparseBytes + DenseBytes));
+
+    std::vector<uint8_t> Out;
+    ASSERT(Pager.Read(SparseHandle, Out));
+    ASSERT(Out == Sparse);
+    ASSERT_EQ(Pager.GetPageCount(), 1);
+
+    // The same page again fits the released range, the next one goes to the end of the file
+    const uint32_t ReusedHandle = Pager.Write(Sparse);
+    const uint32_t AppendedHandle = Pager.Write(Dense);
+    ASSERT(WaitForFileSize(SparseBytes + 2 * DenseBytes));
+
+    ASSERT(Pager.Read(ReusedHandle, Out));
+    ASSERT(Out == Sparse);
+    ASSERT(Pager.Read(DenseHandle, Out));
+    ASSERT(Out == Dense);
+    ASSERT(Pager.Read(AppendedHandle, Out));
+    ASSERT(Out == Dense);
+    ASSERT(!Pager.Read(AppendedHandle, Out));
+    ASSERT_EQ(Pager.GetPageCount(), 0);
+    ASSERT_EQ(Pager.GetCompressedBytes(), 0);
+}
+
 TEST(InitializeTestEntities)
 {
     Registry* Reg = Engine.GetRegistry();
@@ -7,6 +7,8 @@
 #include "Schema.h"
 #include "SchemaReflector.h"
 
+#include <vector>
+
 // Simple test struct (will be replaced with real components in Week 4)
 template <bool MASK = false>
 class TestEntity : public EntityView<TestEntity<MASK>, MASK>
@@ -26,3 +28,151 @@ using MaskedType = TestEntity<true>;
     }
 };
 STRIGID_REGISTER_ENTITY(TestEntity)
+
+// Same components stored in blocks of 8 rows (AoSoA)
+template <bool MASK = false>
+class BlockedTestEntity : public EntityView<BlockedTestEntity<MASK>, MASK>
+{
+using BlockedTestEntitySuper = EntityView<BlockedTestEntity<MASK>, MASK>;
+    Transform<MASK> Transform;
+    Velocity<MASK> Velocity;
+
+public:
+using MaskedType = BlockedTestEntity<true>;
+    static constexpr bool bBlockedLayout = true;
+
+    STRIGID_REGISTER_SCHEMA(BlockedTestEntity, BlockedTestEntitySuper, Transform, Velocity)
+
+    void Update([[maybe_unused]] double dt)
+    {
+        Velocity.vX += 1.0f;
+    }
+};
+STRIGID_REGISTER_ENTITY(BlockedTestEntity)
+
+// One byte of packed flags per row: bit 0 alive, bits 2-3 team
+template <bool MASK = false>
+struct TestFlags : public ComponentView<TestFlags<MASK>, MASK>
+{
+    TestFlags::Bits8Proxy State;
+
+    STRIGID_REGISTER_FIELDS(TestFlags, State)
+
+    auto Alive() { return State.Field(0, 1); }
+    auto Team() { return State.Field(2, 2); }
+};
+STRIGID_REGISTER_COMPONENT(TestFlags)
+
+template <bool MASK = false>
+class FlaggedTestEntity : public EntityView<FlaggedTestEntity<MASK>, MASK>
+{
+using FlaggedTestEntitySuper = EntityView<FlaggedTestEntity<MASK>, MASK>;
+    Transform<MASK> Transform;
+    TestFlags<MASK> Flags;
+
+public:
+using MaskedType = FlaggedTestEntity<true>;
+
+    STRIGID_REGISTER_SCHEMA(FlaggedTestEntity, FlaggedTestEntitySuper, Transform, Flags)
+
+    void Update([[maybe_unused]] double dt)
+    {
+    }
+};
+STRIGID_REGISTER_ENTITY(FlaggedTestEntity)
+
+// Ring-stored, every row expires 3 fixed ticks after the tick that spawned it
+template <bool MASK = false>
+class TransientTestEntity : public EntityView<TransientTestEntity<MASK>, MASK>
+{
+using TransientTestEntitySuper = EntityView<TransientTestEntity<MASK>, MASK>;
+    Transform<MASK> Transform;
+    Velocity<MASK> Velocity;
+
+public:
+using MaskedType = TransientTestEntity<true>;
+    static constexpr uint32_t TransientLifetime = 3;
+
+    STRIGID_REGISTER_SCHEMA(TransientTestEntity, TransientTestEntitySuper, Transform, Velocity)
+};
+STRIGID_REGISTER_ENTITY(TransientTestEntity)
+
+// Records a TestEntity create per batch of 8 rows every fixed tick, from whichever worker runs its chunk
+template <bool MASK = false>
+class SpawnerTestEntity : public EntityView<SpawnerTestEntity<MASK>, MASK>
+{
+using SpawnerTestEntitySuper = EntityView<SpawnerTestEntity<MASK>, MASK>;
+    Transform<MASK> Transform;
+    Velocity<MASK> Velocity;
+
+public:
+using MaskedType = SpawnerTestEntity<true>;
+
+    STRIGID_REGISTER_SCHEMA(SpawnerTestEntity, SpawnerTestEntitySuper, Transform, Velocity)
+
+    void PrePhysics([[maybe_unused]] double dt)
+    {
+        Velocity.vX += 1.0f;
+        this->Reg->GetCommandBuffer().template Create<TestEntity<>>();
+    }
+};
+STRIGID_REGISTER_ENTITY(SpawnerTestEntity)
+
+// No fields, only moves the entity to an archetype with its signature bit set
+STRIGID_TAG_COMPONENT(TestMarked)
+
+// Rarely attached, lives in a sparse set instead of the entity's archetype
+struct TestBuff
+{
+    float TimeLeft;
+    uint32_t Source;
+};
+STRIGID_REGISTER_SPARSE_COMPONENT(TestBuff)
+
+// Times OnDestroy saw each row, indexed by the row's PositionX
+inline std::vector<uint32_t> HookedDestroyCounts;
+
+// Counts its lifecycle hooks: OnCreate bumps vZ, OnDestroy tallies every doomed row
+template <bool MASK = false>
+class HookedTestEntity : public EntityView<HookedTestEntity<MASK>, MASK>
+{
+using HookedTestEntitySuper = EntityView<HookedTestEntity<MASK>, MASK>;
+    Transform<MASK> Transform;
+    Velocity<MASK> Velocity;
+
+public:
+using MaskedType = HookedTestEntity<true>;
+
+    STRIGID_REGISTER_SCHEMA(HookedTestEntity, HookedTestEntitySuper, Transform, Velocity)
+
+    // New rows start from the template row (zero but for ScaleX), so vZ is the number of OnCreate calls
+    static void DefineDefaults(PrefabDefaults& Defaults)
+    {
+        Defaults.Set<::Transform<>>("ScaleX", 1.0f);
+    }
+
+    void OnCreate()
+    {
+        Velocity.vZ += 1.0f;
+    }
+
+    void OnDestroy()
+    {
+        uint32_t Lanes = 0xFF;
+        if constexpr (MASK)
+        {
+            Lanes = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(Transform.PositionX.mask)));
+        }
+
+        alignas(32) float Rows[8];
+        _mm256_store_ps(Rows, Transform.PositionX.Load());
+        for (uint32_t Lane = 0; Lane < 8; ++Lane)
+        {
+            if (Lanes & (1u << Lane))
+            {
+                ++HookedDestroyCounts[static_cast<uint32_t>(Rows[Lane])];
+            }
+        }
+    }
+};
+STRIGID_REGISTER_ENTITY(HookedTestEntity)
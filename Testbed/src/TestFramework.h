@@ -88,7 +88,7 @@ namespace Strigid::Testing
 #define TEST(TestName) \
     void TestName(const StrigidEngine& Engine); \
     static Strigid::Testing::TestRegistrar TestName##_registrar(#TestName, TestName); \
-    void TestName(const StrigidEngine& Engine)
+    void TestName([[maybe_unused]] const StrigidEngine& Engine)
 
 #define ASSERT(condition) \
     if (!(condition)) throw std::runtime_error("Assertion failed: " #condition)
@@ -0,0 +1,80 @@
+#include "WorldSector.h"
+#include "Profiler.h"
+#include "Registry.h"
+#include "Transform.h"
+#include <algorithm>
+#include <cmath>
+
+uint32_t RebaseWorldSectors(Registry& Reg)
+{
+    STRIGID_ZONE_N("World_RebaseSectors");
+
+    constexpr float HALF = WorldSector::SIZE * 0.5f;
+    const ComponentTypeID TransformID = GetComponentTypeID<Transform<>>();
+
+    uint32_t Moved = 0;
+    for (Archetype* Arch : Reg.ComponentQuery<Transform<>, WorldSector>())
+    {
+        if (!Arch)
+            break;
+        const WorldSector* Sector = Reg.GetShared<WorldSector>(Arch);
+        const int32_t PositionField = Arch->GetFieldTableIndex(TransformID); // PositionX, Y, Z come first
+        if (Arch->bTransient || !Sector || PositionField < 0)
+            continue;
+
+        for (size_t chunkIdx = 0; chunkIdx < Arch->Chunks.size(); ++chunkIdx)
+        {
+            Chunk* TargetChunk = Arch->Chunks[chunkIdx];
+            const uint32_t Count = Arch->GetChunkCount(chunkIdx);
+            if (!TargetChunk || Count == 0) // Paged out or empty
+                continue;
+
+            // Most chunks never leave their sector, find that out with one vectorizable pass per axis
+            float Extent = 0.0f;
+            for (int32_t Axis = 0; Axis < 3; ++Axis)
+            {
+                Arch->ForEachFieldRun(TargetChunk, PositionField + Axis, 0, Count, [&](uint8_t* Elements, uint32_t Rows)
+                {
+                    const float* Offsets = reinterpret_cast<const float*>(Elements);
+                    for (uint32_t r = 0; r < Rows; ++r)
+                        Extent = std::max(Extent, std::fabs(Offsets[r]));
+                });
+            }
+            if (Extent <= HALF)
+                continue;
+
+            Arch->MarkChanged(TargetChunk);
+            const EntityID* Ids = Arch->GetEntityIDs(TargetChunk);
+            for (uint32_t Row = 0; Row < Count; ++Row)
+            {
+                float* Offsets[3];
+                int32_t Shift[3];
+                for (int32_t Axis = 0; Axis < 3; ++Axis)
+                {
+                    Offsets[Axis] = reinterpret_cast<float*>(Arch->GetElement(TargetChunk, PositionField + Axis, Row));
+                    const float Offset = *Offsets[Axis];
+                    Shift[Axis] = std::fabs(Offset) > HALF
+                                      ? static_cast<int32_t>(std::floor(Offset / WorldSector::SIZE + 0.5f))
+                                      : 0;
+                }
+                if ((Shift[0] | Shift[1] | Shift[2]) == 0)
+                    continue;
+
+                for (int32_t Axis = 0; Axis < 3; ++Axis)
+                    *Offsets[Axis] -= static_cast<float>(Shift[Axis]) * WorldSector::SIZE;
+
+                Reg.SetShared(Ids[Row], WorldSector{Sector->X + Shift[0], Sector->Y + Shift[1], Sector->Z + Shift[2]});
+                ++Moved;
+            }
+        }
+    }
+
+    // Runs after InvokePostPhys already brought the indexes up to date, fold the rebased rows in as well
+    // so index queries don't see last tick's offsets and sectors
+    if (Moved > 0)
+    {
+        Reg.FlushCommandBuffers();
+        Reg.UpdateIndexes();
+    }
+    return Moved;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+
+#include "SchemaReflector.h"
+
+// WorldSector - Integer cell of a large world, shared per chunk
+// Positions of entities with a sector are float offsets from the sector's origin, so Transform stays
+// 8 floats per SIMD op while the world spans far beyond float precision (SIZE * 2^31 per axis).
+// RebaseWorldSectors moves rows whose offsets drift past half a sector into the neighbouring sector
+struct WorldSector
+{
+    static constexpr float SIZE = 1024.0f;
+
+    int32_t X;
+    int32_t Y;
+    int32_t Z;
+
+    // Sector holding an absolute coordinate, and the coordinate's offset within it
+    static int32_t CellOf(double Coord) { return static_cast<int32_t>(std::floor(Coord / SIZE + 0.5)); }
+    static float OffsetIn(double Coord, int32_t Cell) { return static_cast<float>(Coord - double(Cell) * SIZE); }
+};
+
+STRIGID_REGISTER_SHARED_COMPONENT(WorldSector)
+
+class Registry;
+
+// Move rows of sectored archetypes whose position offsets left [-SIZE/2, SIZE/2] into the sector they drifted
+// into (position shifted by whole sectors, new sector applied through SetShared). Flushes the command buffers and
+// updates the value indexes when a row moved, so call it after InvokePostPhys. Returns how many rows changed sector.
+// Transient archetypes are skipped, their rows can't change archetype
+uint32_t RebaseWorldSectors(Registry& Reg);
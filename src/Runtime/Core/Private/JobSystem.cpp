@@ -0,0 +1,244 @@
+#include "JobSystem.h"
+
+#include "ChunkAllocator.h"
+#include "EngineConfig.h"
+#include "Logger.h"
+#include "Profiler.h"
+
+#include <bit>
+#include <cstdlib>
+
+namespace
+{
+    // Set while a thread is executing jobs, nested dispatches run inline
+    thread_local bool tInsideJob = false;
+    constexpr uint32_t NO_SLOT = UINT32_MAX;
+    thread_local uint32_t tWorkerSlot = NO_SLOT;
+    thread_local uint32_t tCurrentJob = JobSystem::NO_JOB;
+
+    // Slots handed to non-worker threads, bit 0 = slot 0, bit i = MAX_WORKER_SLOTS + i - 1
+    std::atomic<uint32_t> gExternalSlotsInUse{0};
+    static_assert(JobSystem::MAX_EXTERNAL_SLOTS < 32, "External slots are tracked in a 32 bit mask");
+
+    // Owns a non-worker thread's slot, released by the thread_local destructor when the thread exits
+    struct ExternalSlotLease
+    {
+        uint32_t Bit = 32;
+
+        uint32_t Acquire()
+        {
+            uint32_t InUse = gExternalSlotsInUse.load(std::memory_order_relaxed);
+            do
+            {
+                Bit = static_cast<uint32_t>(std::countr_one(InUse));
+                if (Bit > JobSystem::MAX_EXTERNAL_SLOTS)
+                {
+                    // Sharing a slot would let two threads write the same command buffer, so stop here in every build
+                    LOG_FATAL("[JobSystem] Out of thread slots for non-worker threads");
+                    std::abort();
+                }
+            }
+            while (!gExternalSlotsInUse.compare_exchange_weak(InUse, InUse | (1u << Bit), std::memory_order_acq_rel));
+            return Bit == 0 ? 0 : JobSystem::MAX_WORKER_SLOTS + Bit - 1;
+        }
+
+        ~ExternalSlotLease()
+        {
+            if (Bit < 32)
+                gExternalSlotsInUse.fetch_and(~(1u << Bit), std::memory_order_acq_rel);
+        }
+    };
+
+    thread_local ExternalSlotLease tExternalSlot;
+}
+
+JobSystem::~JobSystem()
+{
+    Shutdown();
+}
+
+void JobSystem::Initialize(const EngineConfig* Config)
+{
+    Shutdown();
+
+    int RequestedWorkers = Config ? Config->WorkerThreadCount : -1;
+    if (RequestedWorkers < 0)
+    {
+        // Leave a core each for the main, logic and render threads
+        const int HardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+        RequestedWorkers = HardwareThreads > 3 ? HardwareThreads - 3 : 0;
+    }
+    if (RequestedWorkers > static_cast<int>(MAX_WORKER_SLOTS) - 1)
+    {
+        RequestedWorkers = static_cast<int>(MAX_WORKER_SLOTS) - 1;
+    }
+
+    bNumaAware = Config ? Config->bNumaAwareScheduling : true;
+    QueueCount = bNumaAware ? ChunkAllocator::Get().GetNodeCount() : 1;
+    Queues = std::make_unique<NodeQueue[]>(QueueCount);
+
+    {
+        std::lock_guard<std::mutex> Lock(WakeMutex);
+        bShutdown = false;
+    }
+
+    Workers.reserve(RequestedWorkers);
+    for (int i = 0; i < RequestedWorkers; ++i)
+    {
+        Workers.emplace_back(&JobSystem::WorkerMain, this, static_cast<uint32_t>(i) + 1,
+                             static_cast<uint32_t>(i) % QueueCount);
+    }
+
+    LOG_INFO_F("[JobSystem] %d worker(s) across %u node queue(s)", RequestedWorkers, QueueCount);
+}
+
+void JobSystem::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> Lock(WakeMutex);
+        bShutdown = true;
+    }
+    WakeCV.notify_all();
+
+    for (std::thread& Worker : Workers)
+    {
+        if (Worker.joinable())
+            Worker.join();
+    }
+    Workers.clear();
+}
+
+JobBatchStats JobSystem::Dispatch(uint32_t JobCount, JobFunc Func, void* Context, const uint8_t* PreferredNodes)
+{
+    JobBatchStats Stats;
+    Stats.Jobs = JobCount;
+    if (JobCount == 0)
+        return Stats;
+
+    // Inline path: no workers, trivial batch, or already inside a job
+    if (Workers.empty() || JobCount == 1 || tInsideJob)
+    {
+        const uint32_t OuterJob = tCurrentJob;
+        for (uint32_t i = 0; i < JobCount; ++i)
+        {
+            tCurrentJob = i;
+            Func(Context, i);
+        }
+        tCurrentJob = OuterJob;
+        return Stats;
+    }
+
+    STRIGID_ZONE_N("JobSystem_Dispatch");
+    std::lock_guard<std::mutex> SubmitLock(SubmitMutex);
+
+    // Bucket jobs by preferred node
+    for (uint32_t Node = 0; Node < QueueCount; ++Node)
+    {
+        Queues[Node].Jobs.clear();
+        Queues[Node].Cursor.store(0, std::memory_order_relaxed);
+    }
+    for (uint32_t i = 0; i < JobCount; ++i)
+    {
+        const uint32_t Node = (PreferredNodes && PreferredNodes[i] < QueueCount) ? PreferredNodes[i] : 0;
+        Queues[Node].Jobs.push_back(i);
+    }
+
+    BatchFunc = Func;
+    BatchContext = Context;
+    BatchRemoteJobs.store(0, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> Lock(WakeMutex);
+        ++BatchGeneration;
+        bBatchOpen = true;
+    }
+    WakeCV.notify_all();
+
+    // Caller pulls its weight
+    const uint32_t CallerNode = QueueCount > 1 ? ChunkAllocator::Get().GetCurrentNode() % QueueCount : 0;
+    RunJobs(CallerNode);
+
+    // Every job has been claimed, close the batch and wait for in-flight ones
+    {
+        std::unique_lock<std::mutex> Lock(WakeMutex);
+        bBatchOpen = false;
+        IdleCV.wait(Lock, [this] { return ActiveWorkers == 0; });
+    }
+
+    Stats.RemoteJobs = BatchRemoteJobs.load(std::memory_order_relaxed);
+    return Stats;
+}
+
+uint32_t JobSystem::GetWorkerSlot()
+{
+    if (tWorkerSlot == NO_SLOT) [[unlikely]]
+    {
+        tWorkerSlot = tExternalSlot.Acquire();
+    }
+    return tWorkerSlot;
+}
+
+uint32_t JobSystem::GetCurrentJobIndex()
+{
+    return tCurrentJob;
+}
+
+void JobSystem::WorkerMain(uint32_t Slot, uint32_t Node)
+{
+    tWorkerSlot = Slot;
+
+    if (bNumaAware)
+    {
+        ChunkAllocator::Get().PinCurrentThreadToNode(Node);
+    }
+
+    uint64_t SeenGeneration = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> Lock(WakeMutex);
+            WakeCV.wait(Lock, [&] { return bShutdown || (bBatchOpen && BatchGeneration != SeenGeneration); });
+            if (bShutdown)
+                return;
+
+            SeenGeneration = BatchGeneration;
+            ++ActiveWorkers;
+        }
+
+        RunJobs(Node);
+
+        {
+            std::lock_guard<std::mutex> Lock(WakeMutex);
+            --ActiveWorkers;
+        }
+        IdleCV.notify_one();
+    }
+}
+
+void JobSystem::RunJobs(uint32_t HomeNode)
+{
+    tInsideJob = true;
+    uint32_t Remote = 0;
+
+    for (uint32_t Offset = 0; Offset < QueueCount; ++Offset)
+    {
+        const uint32_t Node = (HomeNode + Offset) % QueueCount;
+        NodeQueue& Queue = Queues[Node];
+        const uint32_t QueueSize = static_cast<uint32_t>(Queue.Jobs.size());
+
+        uint32_t Slot;
+        while ((Slot = Queue.Cursor.fetch_add(1, std::memory_order_relaxed)) < QueueSize)
+        {
+            tCurrentJob = Queue.Jobs[Slot];
+            BatchFunc(BatchContext, tCurrentJob);
+            Remote += (Offset != 0);
+        }
+    }
+
+    if (Remote > 0)
+    {
+        BatchRemoteJobs.fetch_add(Remote, std::memory_order_relaxed);
+    }
+    tCurrentJob = NO_JOB;
+    tInsideJob = false;
+}
@@ -1,9 +1,11 @@
 ﻿#include "LogicThread.h"
 #include "FramePacket.h"
 #include "Registry.h"
+#include "SimulationWorld.h"
 #include "EngineConfig.h"
 #include "Profiler.h"
 #include "Logger.h"
+#include "WorldSector.h"
 #include <SDL3/SDL.h>
 
 void LogicThread::Initialize(Registry* registry, const EngineConfig* config, int windowWidth, int windowHeight)
@@ -23,6 +25,11 @@ void LogicThread::Initialize(Registry* registry, const EngineConfig* config, int
     LOG_INFO("[LogicThread] Initialized with triple-buffer mailbox");
 }
 
+void LogicThread::AddWorld(SimulationWorld* World)
+{
+    HostedWorlds.push_back(World);
+}
+
 void LogicThread::Start()
 {
     bIsRunning.store(true, std::memory_order_release);
@@ -139,6 +146,12 @@ void LogicThread::ThreadMain()
         // Variable update
         Update(dt);
 
+        // Hosted worlds keep their own clocks, just feed them the frame time
+        if (!HostedWorlds.empty())
+        {
+            SimulationWorld::StepAll(HostedWorlds.data(), static_cast<uint32_t>(HostedWorlds.size()), dt);
+        }
+
         // Frame limiter (if MaxFPS is set in config)
         if (ConfigPtr->TargetFPS > 0)
         {
@@ -166,6 +179,8 @@ void LogicThread::PostPhysics(double dt)
     STRIGID_ZONE_N("Logic_FixedUpdate");
 
     RegistryPtr->InvokePostPhys(dt);
+    RebaseWorldSectors(*RegistryPtr);
+    StateChecksum = RegistryPtr->ComputeStateChecksum();
 
     SimulationTime += dt;
 }
@@ -176,6 +191,7 @@ void LogicThread::ProduceFramePacket()
 
     // Fill staging packet
     StagingPacket->SimulationTime = SimulationTime;
+    StagingPacket->StateChecksum = StateChecksum;
     StagingPacket->ActiveEntityCount = static_cast<uint32_t>(RegistryPtr->GetTotalEntityCount());
     StagingPacket->FrameNumber = ++FrameNumber;
 
@@ -214,6 +230,9 @@ void LogicThread::ProduceFramePacket()
     StagingPacket->View.CameraPosition.x = 0.0f;
     StagingPacket->View.CameraPosition.y = 0.0f;
     StagingPacket->View.CameraPosition.z = 0.0f;
+    StagingPacket->View.SectorX = 0;
+    StagingPacket->View.SectorY = 0;
+    StagingPacket->View.SectorZ = 0;
 
     // TODO: Fill SceneState (sun direction, color)
 
@@ -0,0 +1,54 @@
+#include "SimulationWorld.h"
+
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "WorldSector.h"
+
+SimulationWorld::SimulationWorld(const EngineConfig& Config)
+    : WorldConfig(Config)
+      , WorldRegistry(&WorldConfig)
+      , FixedStepTime(WorldConfig.GetFixedStepTime())
+{
+}
+
+uint32_t SimulationWorld::Advance(double dt)
+{
+    STRIGID_ZONE_N("World_Advance");
+
+    // Same safety caps as LogicThread
+    constexpr double kMaxDt = 0.25;
+    constexpr double kMaxAccumulatedTime = 0.25;
+    constexpr uint32_t kMaxPhysSubSteps = 8;
+
+    if (dt > kMaxDt) dt = kMaxDt;
+
+    Accumulator += dt;
+    if (Accumulator > kMaxAccumulatedTime) Accumulator = kMaxAccumulatedTime;
+
+    uint32_t Steps = 0;
+    while (Accumulator >= FixedStepTime && Steps < kMaxPhysSubSteps)
+    {
+        WorldRegistry.InvokePrePhys(FixedStepTime);
+        WorldRegistry.InvokePostPhys(FixedStepTime);
+        RebaseWorldSectors(WorldRegistry);
+        StateChecksum = WorldRegistry.ComputeStateChecksum();
+
+        Accumulator -= FixedStepTime;
+        SimulationTime += FixedStepTime;
+        ++FixedStepCount;
+        ++Steps;
+    }
+
+    WorldRegistry.InvokeUpdate(dt);
+    return Steps;
+}
+
+void SimulationWorld::StepAll(SimulationWorld* const* Worlds, uint32_t WorldCount, double dt)
+{
+    STRIGID_ZONE_N("World_StepAll");
+
+    JobSystem::Get().ParallelFor(WorldCount, [&](uint32_t WorldIndex)
+    {
+        Worlds[WorldIndex]->Advance(dt);
+    });
+}
@@ -2,7 +2,9 @@
 #include <iostream>
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_gpu.h>
+#include "ChunkAllocator.h"
 #include "EngineConfig.h"
+#include "JobSystem.h"
 #include "Logger.h"
 #include "LogicThread.h"
 #include "Profiler.h"
@@ -78,6 +80,10 @@ bool StrigidEngine::Initialize(const char* title, int width, int height)
         return false;
     }
 
+    // Chunk placement and workers must be up before the Registry allocates anything
+    ChunkAllocator::Get().Initialize(&Config);
+    JobSystem::Get().Initialize(&Config);
+
     // Create Registry
     RegistryPtr = std::make_unique<Registry>(&Config);
     Pacer.Initialize(GpuDevice);
@@ -143,6 +149,8 @@ void StrigidEngine::Shutdown()
     if (Logic) Logic->Join();
     if (Render) Render->Join();
 
+    JobSystem::Get().Shutdown();
+
     // Cleanup window
     if (EngineWindow)
     {
@@ -9,4 +9,7 @@ struct ComponentView
     using UIntProxy = FieldProxy<uint32_t, MASK>;
     using Int64Proxy = FieldProxy<int64_t, MASK>;
     using UInt64Proxy = FieldProxy<uint64_t, MASK>;
+    using Bits8Proxy = BitFieldProxy<uint8_t, MASK>;
+    using Bits16Proxy = BitFieldProxy<uint16_t, MASK>;
+    using Bits32Proxy = BitFieldProxy<uint32_t, MASK>;
 };
@@ -1,4 +1,13 @@
 ﻿#pragma once
+#include <cstdint>
+
+// How archetype chunks are spread across NUMA nodes (see ChunkAllocator)
+enum class NumaChunkPolicy : uint8_t
+{
+    FirstTouch, // Let the OS decide (chunk lands near whichever thread allocates it)
+    Interleave, // Round-robin consecutive chunks of an archetype across nodes
+    Partition // Keep each archetype's chunks on a single node, archetypes spread across nodes
+};
 
 struct EngineConfig
 {
@@ -22,6 +31,26 @@ struct EngineConfig
     // Number of History buffer pages, min 8. Must be power of 2.
     int HistoryBufferPages = 128; // 128 at 128 FixedHz 1 second history.
 
+    // Job system worker count. -1 = hardware threads minus Sentinel/Brain/Encoder, 0 = run jobs inline.
+    int WorkerThreadCount = -1;
+
+    // NUMA placement of archetype chunks, no-op on single node machines.
+    NumaChunkPolicy ChunkPlacement = NumaChunkPolicy::Interleave;
+
+    // Route chunk jobs to workers pinned to the chunk's node (workers still steal when idle).
+    bool bNumaAwareScheduling = true;
+
+    // Classes with the same components (in the same schema order) and defaults share one archetype's chunks.
+    // Rows are kept sorted into one run per class, each run still gets its own class kernel.
+    bool bMergeSameSignatureClasses = false;
+
+    // Chunks of deactivated entities untouched for this long are compressed into a page file and their memory
+    // returned to the chunk pool, they're paged back in on access or activation. 0 = never page out.
+    int DormantChunkPageOutSeconds = 0;
+
+    // Page file prefix, each registry appends its own suffix
+    const char* PageFilePath = "StrigidChunkPages";
+
     // --- Helpers ---
     double GetTargetFrameTime() const
     {
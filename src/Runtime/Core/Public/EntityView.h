@@ -71,7 +71,7 @@ public:
         // what do?
     }
 
-    __forceinline void Hydrate(void** fieldArrayTable, uint32_t index = 0, int32_t count = -1)
+    __forceinline void Hydrate(void** fieldArrayTable, uint32_t index = 0, int32_t count = -1, uint32_t blockStride = 0)
     {
         constexpr auto schema = T::DefineSchema();
 
@@ -87,7 +87,7 @@ public:
                     // Check if this is a FieldProxy<T>
                     if constexpr (HasDefineFields<MemberType>)
                     {
-                        (static_cast<T*>(this)->*member).Bind(&fieldArrayTable[fieldArrayBaseIndex], index, count);
+                        (static_cast<T*>(this)->*member).Bind(&fieldArrayTable[fieldArrayBaseIndex], index, count, blockStride);
 
                         // Advance by number of fields for this component
                         constexpr size_t fieldCount = MemberType::FieldNames.size();
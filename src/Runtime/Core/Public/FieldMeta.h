@@ -22,6 +22,9 @@ struct ComponentMetaEx
     bool IsFieldDecomposed; // True if stored as field arrays (SoA)
     bool IsHot; // True if this component should live in Sparse Data
     std::vector<FieldMeta> Fields; // Field layout if decomposed
+    bool IsTag = false; // Zero-size marker, only exists as a signature bit
+    bool IsShared = false; // One value per chunk, stored in the SharedComponentStore
+    bool IsSparse = false; // Stored in a per-registry SparseSet instead of archetype chunks
 };
 
 // Component field registry - static storage for field decomposition info
@@ -50,6 +53,52 @@ public:
         for (const auto& field : meta.Fields) meta.Size += field.Size;
     }
 
+    // Register a zero-size tag component (no fields, takes no chunk space)
+    void RegisterTag(ComponentTypeID typeID)
+    {
+        ComponentMetaEx& meta = ComponentData[typeID];
+        meta.TypeID = typeID;
+        meta.IsTag = true;
+    }
+
+    // Register a shared component (one value per chunk, no per-row storage)
+    void RegisterShared(ComponentTypeID typeID, size_t size, size_t alignment)
+    {
+        ComponentMetaEx& meta = ComponentData[typeID];
+        meta.TypeID = typeID;
+        meta.Size = size;
+        meta.Alignment = alignment;
+        meta.IsShared = true;
+    }
+
+    // Register a sparse-set component (never part of an archetype signature)
+    void RegisterSparse(ComponentTypeID typeID, size_t size, size_t alignment)
+    {
+        ComponentMetaEx& meta = ComponentData[typeID];
+        meta.TypeID = typeID;
+        meta.Size = size;
+        meta.Alignment = alignment;
+        meta.IsSparse = true;
+    }
+
+    [[nodiscard]] bool IsShared(ComponentTypeID typeID) const
+    {
+        auto it = ComponentData.find(typeID);
+        return it != ComponentData.end() && it->second.IsShared;
+    }
+
+    [[nodiscard]] bool IsHot(ComponentTypeID typeID) const
+    {
+        auto it = ComponentData.find(typeID);
+        return it != ComponentData.end() && it->second.IsHot;
+    }
+
+    [[nodiscard]] bool IsTag(ComponentTypeID typeID) const
+    {
+        auto it = ComponentData.find(typeID);
+        return it != ComponentData.end() && it->second.IsTag;
+    }
+
     // Get field layout for a component
     [[nodiscard]] const std::vector<FieldMeta>* GetFields(ComponentTypeID typeID) const
     {
@@ -1,12 +1,20 @@
 #pragma once
+#include <cassert>
 #include <cstdint>
+#include <cstring>
 #include <type_traits>
 #include <immintrin.h>
 
 namespace FieldProxyConsts
 {
     static const __m256i element_indices = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7); // Indices of elements
-    
+    static const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128); // Bit of each lane in a lane mask
+
+    // Lane mask (bit i = lane i, as returned by DestroyWhere predicates) to a vector mask
+    __forceinline __m256i ExpandLanes(uint32_t lanes)
+    {
+        return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(static_cast<int32_t>(lanes)), lane_bits), lane_bits);
+    }
 }
 
 // SIMD type traits for selecting correct intrinsics
@@ -83,6 +91,7 @@ struct FieldProxy
 {
     FieldType* __restrict array;
     uint32_t index;
+    uint32_t batchStride = 8; // Elements from one 8-row batch to the next, a whole block in a blocked layout
     __m256i mask = _mm256_set1_epi64x(-1);  // Only used when UseMask = true
 
     FieldProxy() 
@@ -92,6 +101,11 @@ struct FieldProxy
     operator FieldType() const { return array[index]; }
 
 using Traits = SIMDTraits<FieldType, MASK>;
+
+    // All 8 lanes in one register, for predicate kernels (see Registry::DestroyWhere)
+    // Lanes past a masked tail hold whatever follows the live rows
+    __forceinline typename Traits::VecType Load() const { return Traits::load(&array[index]); }
+
     __forceinline FieldProxy& operator=(FieldType value)
     {
         Traits::store(&array[index], mask, Traits::set1(value));
@@ -131,18 +145,193 @@ using Traits = SIMDTraits<FieldType, MASK>;
         return *this;
     }
 
-    __forceinline void Bind(void* bindArray, uint32_t startIndex = 0, int32_t startCount = -1)
+    // blockStride is the byte size of one 8-row block of a blocked (AoSoA) archetype, 0 for plain SoA arrays
+    // A row's element then sits in its block's run of 8 for this field, at its lane
+    __forceinline void Bind(void* bindArray, uint32_t startIndex = 0, int32_t startCount = -1, uint32_t blockStride = 0)
     {
         array = (FieldType*)bindArray;
-        index = startIndex;
+        batchStride = blockStride ? blockStride / static_cast<uint32_t>(sizeof(FieldType)) : 8;
+        index = (startIndex / 8) * batchStride + startIndex % 8;
         
         const __m256i count_vec = _mm256_set1_epi32(startCount);
         mask = _mm256_cmpgt_epi32(count_vec, FieldProxyConsts::element_indices);
     }
 
+    // Store only the lanes set in lanes (bit i = lane i), e.g. a lane mask from a BitField as a per-row filter
+    __forceinline void StoreWhere(uint32_t lanes, typename Traits::VecType value)
+    {
+        __m256i laneMask = FieldProxyConsts::ExpandLanes(lanes);
+        if constexpr (MASK) { laneMask = _mm256_and_si256(laneMask, mask); }
+        SIMDTraits<FieldType, true>::store(&array[index], laneMask, value);
+    }
+
+    // Steps are whole batches
     __forceinline void Advance(uint32_t step)
     {
-        index += step;
+        index += (step / 8) * batchStride;
+    }
+};
+
+// Word types a BitFieldProxy packs its bits into, widened to 8 x 32-bit lanes and narrowed back
+template <typename Word>
+struct PackedWordTraits;
+
+template <>
+struct PackedWordTraits<uint8_t>
+{
+    static __forceinline __m256i widen(const uint8_t* ptr) { return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)ptr)); }
+    static __forceinline void narrow(uint8_t* ptr, __m256i lanes)
+    {
+        const __m256i words = _mm256_packus_epi32(lanes, lanes);
+        const __m256i bytes = _mm256_packus_epi16(words, words);
+        _mm_storel_epi64((__m128i*)ptr, _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0))));
+    }
+};
+
+template <>
+struct PackedWordTraits<uint16_t>
+{
+    static __forceinline __m256i widen(const uint16_t* ptr) { return _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)ptr)); }
+    static __forceinline void narrow(uint16_t* ptr, __m256i lanes)
+    {
+        const __m256i words = _mm256_permute4x64_epi64(_mm256_packus_epi32(lanes, lanes), 0b1000);
+        _mm_storeu_si128((__m128i*)ptr, _mm256_castsi256_si128(words));
+    }
+};
+
+template <>
+struct PackedWordTraits<uint32_t>
+{
+    static __forceinline __m256i widen(const uint32_t* ptr) { return _mm256_loadu_si256((const __m256i*)ptr); }
+    static __forceinline void narrow(uint32_t* ptr, __m256i lanes) { _mm256_storeu_si256((__m256i*)ptr, lanes); }
+};
+
+template <typename Word, bool MASK>
+struct BitFieldProxy;
+
+// A few bits (1, 2 or 4) of a BitFieldProxy's word, e.g. a flag or a small enum. All 8 lanes are read and written
+// at once: lane masks come back as bit i = lane i (the DestroyWhere predicate format, plain integer logic combines
+// them) and stores insert the bits into the selected lanes only, the rest of each word is kept
+template <typename Word, bool MASK>
+struct BitField
+{
+    BitFieldProxy<Word, MASK>* proxy;
+    uint32_t shift;
+    uint32_t bits; // Field mask, already shifted
+
+    // Field values of the 8 lanes
+    __forceinline __m256i Load() const
+    {
+        return _mm256_srl_epi32(_mm256_and_si256(proxy->Load(), _mm256_set1_epi32(static_cast<int32_t>(bits))),
+                                _mm_cvtsi32_si128(static_cast<int32_t>(shift)));
+    }
+
+    // Lanes whose field isn't 0 (a flag's set lanes)
+    __forceinline uint32_t Mask() const
+    {
+        const __m256i field = _mm256_and_si256(proxy->Load(), _mm256_set1_epi32(static_cast<int32_t>(bits)));
+        const uint32_t zero = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(field, _mm256_setzero_si256())));
+        return ~zero & proxy->liveLanes;
+    }
+
+    // Lanes whose field equals value
+    __forceinline uint32_t Equals(uint32_t value) const
+    {
+        const __m256i field = _mm256_and_si256(proxy->Load(), _mm256_set1_epi32(static_cast<int32_t>(bits)));
+        const __m256i wanted = _mm256_set1_epi32(static_cast<int32_t>((value << shift) & bits));
+        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(field, wanted))) & proxy->liveLanes;
+    }
+
+    // Masked bit insertion: value goes into the field of the lanes set in lanes
+    __forceinline void Store(uint32_t lanes, uint32_t value)
+    {
+        const __m256i words = proxy->Load();
+        const __m256i select = _mm256_and_si256(FieldProxyConsts::ExpandLanes(lanes & proxy->liveLanes),
+                                                _mm256_set1_epi32(static_cast<int32_t>(bits)));
+        const __m256i inserted = _mm256_and_si256(_mm256_set1_epi32(static_cast<int32_t>(value << shift)), select);
+        proxy->Store(_mm256_or_si256(_mm256_andnot_si256(select, words), inserted));
+    }
+
+    __forceinline void Set(uint32_t lanes) { Store(lanes, bits >> shift); }
+    __forceinline void Clear(uint32_t lanes) { Store(lanes, 0); }
+
+    __forceinline BitField& operator=(uint32_t value)
+    {
+        Store(0xFF, value);
+        return *this;
+    }
+
+    operator uint32_t() const { return (static_cast<uint32_t>(*proxy) & bits) >> shift; }
+};
+
+// Field array of small words that pack several narrow fields per row, read through BitField views
+// One 8 bit word holds 8 flags, so flag-heavy components cost a bit per flag per row instead of a whole int
+// Declare accessors on the component, e.g. auto Alive() { return State.Field(0, 1); }
+template <typename Word, bool MASK>
+struct BitFieldProxy
+{
+    static_assert(std::is_unsigned_v<Word> && sizeof(Word) <= 4, "Bit fields pack into 8, 16 or 32 bit words");
+
+    Word* __restrict array;
+    uint32_t index;
+    uint32_t batchStride = 8;
+    uint32_t liveLanes = 0xFF; // Lanes holding rows, fewer than 8 only in a masked tail
+    uint32_t liveCount = 8;
+
+    operator Word() const { return array[index]; }
+
+    // Bits [shift, shift + width) of every word, width 1, 2 or 4
+    __forceinline BitField<Word, MASK> Field(uint32_t shift, uint32_t width)
+    {
+        assert((width == 1 || width == 2 || width == 4) && shift + width <= sizeof(Word) * 8);
+        return BitField<Word, MASK>{this, shift, ((1u << width) - 1) << shift};
+    }
+
+    // Whole words of the 8 lanes, zero extended. A masked tail only reads its live rows' words, the lanes past
+    // them are 0 (the full-width load could run off the end of the column)
+    __forceinline __m256i Load() const
+    {
+        if constexpr (MASK)
+        {
+            if (liveCount < 8)
+            {
+                alignas(32) Word words[8] = {};
+                std::memcpy(words, &array[index], liveCount * sizeof(Word));
+                return PackedWordTraits<Word>::widen(words);
+            }
+        }
+        return PackedWordTraits<Word>::widen(&array[index]);
+    }
+
+    // A masked tail only writes back its live rows' words
+    __forceinline void Store(__m256i words)
+    {
+        if constexpr (MASK)
+        {
+            if (liveCount < 8)
+            {
+                alignas(32) Word narrowed[8];
+                PackedWordTraits<Word>::narrow(narrowed, words);
+                std::memcpy(&array[index], narrowed, liveCount * sizeof(Word));
+                return;
+            }
+        }
+        PackedWordTraits<Word>::narrow(&array[index], words);
+    }
+
+    // Same addressing as FieldProxy::Bind
+    __forceinline void Bind(void* bindArray, uint32_t startIndex = 0, int32_t startCount = -1, uint32_t blockStride = 0)
+    {
+        array = (Word*)bindArray;
+        batchStride = blockStride ? blockStride / static_cast<uint32_t>(sizeof(Word)) : 8;
+        index = (startIndex / 8) * batchStride + startIndex % 8;
+        liveCount = (startCount < 0 || startCount > 8) ? 8 : static_cast<uint32_t>(startCount);
+        liveLanes = (1u << liveCount) - 1;
+    }
+
+    __forceinline void Advance(uint32_t step)
+    {
+        index += (step / 8) * batchStride;
     }
 };
 
@@ -155,4 +344,8 @@ struct IsFieldProxy : std::false_type
 template <typename T, bool MASK>
 struct IsFieldProxy<FieldProxy<T, MASK>> : std::true_type
 {
-};
\ No newline at end of file
+};
+template <typename Word, bool MASK>
+struct IsFieldProxy<BitFieldProxy<Word, MASK>> : std::true_type
+{
+};
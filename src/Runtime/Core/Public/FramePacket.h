@@ -8,7 +8,8 @@ struct ViewState
 {
     Matrix4 ViewMatrix;
     Matrix4 ProjectionMatrix;
-    Vector3 CameraPosition;
+    Vector3 CameraPosition; // Relative to the camera's sector
+    int32_t SectorX, SectorY, SectorZ; // Camera's WorldSector, render positions are rebased against it
 };
 
 /**
@@ -33,6 +34,7 @@ struct alignas(64) FramePacket
 
     // Timing
     double SimulationTime; // Current simulation time
+    uint64_t StateChecksum; // Registry::ComputeStateChecksum after the last fixed step, compare across peers/runs
 
     // Snapshot Metadata
     uint32_t ActiveEntityCount; // How many entities in the sparse arrays
@@ -0,0 +1,117 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+struct EngineConfig;
+
+// Results of a single Dispatch, mostly for profiling
+struct JobBatchStats
+{
+    uint32_t Jobs = 0;
+    uint32_t RemoteJobs = 0; // Jobs that ran on a different NUMA node than they asked for
+};
+
+using JobFunc = void(*)(void* Context, uint32_t JobIndex);
+
+/**
+ * JobSystem: fork/join worker pool for chunk-granular work
+ *
+ * Workers are spread round-robin across NUMA nodes and pinned to their node's CPUs.
+ * Each Dispatch fills one queue per node using the optional PreferredNodes hint
+ * (normally the chunk's ChunkHeader::NumaNode). Workers drain their own node's queue first
+ * and only steal from other nodes once it is empty, so chunk data is mostly touched by
+ * cores sharing its memory controller.
+ *
+ * The calling thread participates in the batch and Dispatch returns once every job ran.
+ * Dispatch from inside a job runs inline on the calling worker.
+ */
+class JobSystem
+{
+public:
+    static constexpr uint32_t MAX_WORKER_SLOTS = 64; // Caller slot + workers
+    static constexpr uint32_t MAX_EXTERNAL_SLOTS = 16; // Extra slots for non-worker threads (logic, network, loaders...)
+    static constexpr uint32_t MAX_THREAD_SLOTS = MAX_WORKER_SLOTS + MAX_EXTERNAL_SLOTS;
+    static constexpr uint32_t NO_JOB = UINT32_MAX;
+
+    static JobSystem& Get()
+    {
+        static JobSystem Instance;
+        return Instance;
+    }
+
+    // Spawn workers (EngineConfig::WorkerThreadCount, -1 = auto, 0 = run everything inline)
+    void Initialize(const EngineConfig* Config);
+
+    // Join all workers
+    void Shutdown();
+
+    // Run Func(Context, i) for i in [0, JobCount), blocking until all are done
+    // PreferredNodes: optional per-job NUMA node hint (JobCount entries)
+    JobBatchStats Dispatch(uint32_t JobCount, JobFunc Func, void* Context, const uint8_t* PreferredNodes = nullptr);
+
+    template <typename Fn>
+    JobBatchStats ParallelFor(uint32_t JobCount, Fn&& Body, const uint8_t* PreferredNodes = nullptr)
+    {
+        using BodyType = std::remove_reference_t<Fn>;
+        return Dispatch(JobCount, [](void* Context, uint32_t JobIndex)
+                        {
+                            (*static_cast<BodyType*>(Context))(JobIndex);
+                        }, const_cast<void*>(static_cast<const void*>(&Body)), PreferredNodes);
+    }
+
+    uint32_t GetWorkerCount() const { return static_cast<uint32_t>(Workers.size()); }
+
+    // Stable per-thread slot for per-thread storage, below MAX_THREAD_SLOTS. Workers own 1..MAX_WORKER_SLOTS-1,
+    // any other thread is given a free slot of its own on its first call (slot 0, then MAX_WORKER_SLOTS and up)
+    // and gives it back when it exits. At most MAX_EXTERNAL_SLOTS + 1 non-worker threads may hold one at once,
+    // one more aborts the process
+    static uint32_t GetWorkerSlot();
+
+    // Index of the job the calling thread is executing within its Dispatch, NO_JOB outside of jobs
+    static uint32_t GetCurrentJobIndex();
+
+private:
+    JobSystem() = default;
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void WorkerMain(uint32_t Slot, uint32_t Node);
+
+    // Claim and run jobs from the batch, own node first then steal
+    void RunJobs(uint32_t HomeNode);
+
+    struct alignas(64) NodeQueue
+    {
+        std::vector<uint32_t> Jobs;
+        std::atomic<uint32_t> Cursor{0};
+    };
+
+    std::vector<std::thread> Workers;
+    std::unique_ptr<NodeQueue[]> Queues;
+    uint32_t QueueCount = 1;
+    bool bNumaAware = true;
+
+    // Current batch
+    JobFunc BatchFunc = nullptr;
+    void* BatchContext = nullptr;
+    std::atomic<uint32_t> BatchRemoteJobs{0};
+
+    // Serializes callers from different threads (e.g. multiple worlds)
+    std::mutex SubmitMutex;
+
+    // Worker wake/park
+    std::mutex WakeMutex;
+    std::condition_variable WakeCV;
+    std::condition_variable IdleCV;
+    uint64_t BatchGeneration = 0;
+    uint32_t ActiveWorkers = 0;
+    bool bBatchOpen = false;
+    bool bShutdown = false;
+};
@@ -1,11 +1,13 @@
 ﻿#pragma once
 #include <thread>
 #include <atomic>
+#include <vector>
 
 #include "Registry.h"
 
 // Forward declarations
 class Registry;
+class SimulationWorld;
 struct EngineConfig;
 struct InputState;
 struct FramePacket;
@@ -16,6 +18,7 @@ struct FramePacket;
  * Runs simulation at FixedUpdateHz with accumulator/substepping
  * Produces FramePackets for Render thread consumption via triple-buffer mailbox
  * Owns the mailbox setup
+ * Can host extra headless SimulationWorlds, stepped in parallel once per frame
  */
 class LogicThread
 {
@@ -28,6 +31,9 @@ public:
     void Stop();
     void Join();
 
+    // Host an additional world (non-owning). Must be called before Start()
+    void AddWorld(SimulationWorld* World);
+
     // Mailbox access for RenderThread
     std::shared_ptr<FramePacket> ExchangeMailbox(std::shared_ptr<FramePacket> visualPacket);
     // CAS swap: give visualPacket, get mailbox packet
@@ -51,6 +57,7 @@ private:
     // References (non-owning)
     Registry* RegistryPtr = nullptr;
     const EngineConfig* ConfigPtr = nullptr;
+    std::vector<SimulationWorld*> HostedWorlds;
 
     // Input (future)
     InputState* CurrentInput = nullptr;
@@ -71,6 +78,7 @@ private:
     // Timing
     double Accumulator = 0.0;
     double SimulationTime = 0.0;
+    uint64_t StateChecksum = 0; // Of the registry after the last fixed step
     uint32_t FrameNumber = 0;
     int WindowWidth = 1920;
     int WindowHeight = 1080;
@@ -1,7 +1,11 @@
 #pragma once
+#include <concepts>
+#include <cstring>
 #include <functional>
 #include <Logger.h>
+#include <string_view>
 #include <tuple>
+#include <type_traits>
 #include <unordered_set>
 
 #include "Profiler.h"
@@ -20,11 +24,91 @@ template <typename T> concept HasOnDeactivate = requires(T t) { t.OnDeactivate()
 template <typename T> concept HasOnCollide = requires(T t) { t.OnCollide(); };
 template <typename T> concept HasDefineSchema = requires(T t) { t.DefineSchema(); };
 template <typename T> concept HasDefineFields = requires(T t) { t.DefineFields(); };
+template <typename T> concept IsTagComponent = requires { T::bTagComp; } && T::bTagComp;
 
-using UpdateFunc = void(*)(double, void**, uint32_t);
+// Specialized by STRIGID_REGISTER_SHARED_COMPONENT
+template <typename T> struct SharedComponentTrait : std::false_type {};
+template <typename T> concept IsSharedComponent = SharedComponentTrait<T>::value;
+
+// Specialized by STRIGID_REGISTER_SPARSE_COMPONENT
+template <typename T> struct SparseComponentTrait : std::false_type {};
+template <typename T> concept IsSparseComponent = SparseComponentTrait<T>::value;
+
+// One default field value declared by an entity class, Bits holds the value's bytes (zero extended)
+struct FieldDefault
+{
+    ComponentTypeID TypeID;
+    uint32_t FieldIndex;
+    uint32_t Size;
+    uint64_t Bits;
+
+    bool operator==(const FieldDefault& Other) const = default;
+};
+
+// Builder passed to an entity class's DefineDefaults, e.g.
+//   static void DefineDefaults(PrefabDefaults& Defaults) { Defaults.Set<Transform<>>("ScaleX", 1.0f); }
+// Fields without a default start zeroed. Built into a template row per archetype that Create stamps into new rows
+class PrefabDefaults
+{
+public:
+    template <typename C, typename V>
+    void Set(uint32_t FieldIndex, V Value)
+    {
+        static_assert(std::is_trivially_copyable_v<V> && sizeof(V) <= sizeof(uint64_t),
+                      "Default values must be trivially copyable scalars");
+
+        FieldDefault Default{GetComponentTypeID<C>(), FieldIndex, sizeof(V), 0};
+        std::memcpy(&Default.Bits, &Value, sizeof(V));
+        Fields.push_back(Default);
+    }
+
+    template <typename C, typename V>
+    void Set(std::string_view FieldName, V Value)
+    {
+        for (uint32_t i = 0; i < C::FieldNames.size(); ++i)
+        {
+            if (FieldName == C::FieldNames[i])
+            {
+                Set<C>(i, Value);
+                return;
+            }
+        }
+        LOG_ERROR_F("Default for unknown field '%.*s' ignored", static_cast<int>(FieldName.size()), FieldName.data());
+    }
+
+    std::vector<FieldDefault> Fields;
+};
+
+template <typename T> concept HasDefineDefaults = requires(PrefabDefaults& Defaults) { T::DefineDefaults(Defaults); };
+
+// Short-lived classes (projectiles, hit effects, debris) opt into ring storage with a lifetime in fixed ticks:
+//   static constexpr uint32_t TransientLifetime = 30;
+template <typename T> concept HasTransientLifetime = requires { { T::TransientLifetime } -> std::convertible_to<uint32_t>; };
+
+// Classes read mostly a row at a time (GetField, gathers, network apply) can opt into a blocked (AoSoA) layout,
+// every field of 8 rows then shares a block instead of each field spanning the chunk:
+//   static constexpr bool bBlockedLayout = true;
+template <typename T> concept HasBlockedLayout = requires { { T::bBlockedLayout } -> std::convertible_to<bool>; } && T::bBlockedLayout;
+
+class Registry;
+
+// Kernels get the owning Registry so views can record structural commands (Reg->Destroy etc.)
+using UpdateFunc = void(*)(Registry*, double, void**, uint32_t);
+
+// A kernel's count word: rows in the low bits, the byte size of one 8-row block above them when the archetype
+// is blocked (0 = SoA), see Archetype::GetKernelCount
+static constexpr uint32_t KERNEL_ROW_BITS = 16;
+
+constexpr uint32_t PackKernelCount(uint32_t Rows, size_t BlockStride)
+{
+    return Rows | static_cast<uint32_t>(BlockStride << KERNEL_ROW_BITS);
+}
+
+constexpr uint32_t GetKernelRows(uint32_t CountWord) { return CountWord & ((1u << KERNEL_ROW_BITS) - 1); }
+constexpr uint32_t GetKernelBlockStride(uint32_t CountWord) { return CountWord >> KERNEL_ROW_BITS; }
 
 #define REGISTER_ENTITY_PREPHYS(Type, ClassID) \
-    case ClassID: InvokePrePhysicsImpl<Type>(dt, fieldArrayTable, componentCount); break;
+    case ClassID: InvokePrePhysicsImpl<Type>(Reg, dt, fieldArrayTable, componentCount); break;
 
 struct EntityMeta
 {
@@ -34,6 +118,20 @@ struct EntityMeta
     UpdateFunc PostPhys = nullptr;
     UpdateFunc Update = nullptr;
 
+    // Batched hooks run over the rows moved by Registry::Activate/Deactivate (dt is unused)
+    UpdateFunc OnActivate = nullptr;
+    UpdateFunc OnDeactivate = nullptr;
+
+    // Batched hooks run over freshly created rows and over rows about to be destroyed
+    UpdateFunc OnCreate = nullptr;
+    UpdateFunc OnDestroy = nullptr;
+
+    // Fixed ticks a row of a transient class lives (0 = regular storage), see Registry::SpawnTransient
+    uint32_t TransientLifetime = 0;
+
+    // Rows are stored in blocks of 8 (see HasBlockedLayout)
+    bool bBlockedLayout = false;
+
     EntityMeta(){}
     EntityMeta(const size_t inViewSize, const UpdateFunc prePhys, const UpdateFunc postPhys, const UpdateFunc update)
         : ViewSize(inViewSize)
@@ -47,18 +145,28 @@ struct EntityMeta
         , PrePhys(rhs.PrePhys)
         , PostPhys(rhs.PostPhys)
         , Update(rhs.Update)
+        , OnActivate(rhs.OnActivate)
+        , OnDeactivate(rhs.OnDeactivate)
+        , OnCreate(rhs.OnCreate)
+        , OnDestroy(rhs.OnDestroy)
+        , TransientLifetime(rhs.TransientLifetime)
+        , bBlockedLayout(rhs.bBlockedLayout)
     {}
 };
 
 template <typename T>
-__forceinline void InvokePrePhysicsImpl(double dt, void** fieldArrayTable, uint32_t componentCount)
+__forceinline void InvokePrePhysicsImpl(Registry* Reg, double dt, void** fieldArrayTable, uint32_t componentCount)
 {
     alignas(32) T viewBatch;
+    viewBatch.Reg = Reg;
+
+    const uint32_t blockStride = GetKernelBlockStride(componentCount);
+    componentCount = GetKernelRows(componentCount);
 
     constexpr uint32_t SIMD_BATCH = 8;
     const uint32_t batchCount = componentCount / SIMD_BATCH;
 
-    viewBatch.Hydrate(fieldArrayTable);
+    viewBatch.Hydrate(fieldArrayTable, 0, -1, blockStride);
 
     // Process batches
     for (uint32_t i = 0; i < batchCount; i++)
@@ -67,23 +175,32 @@ __forceinline void InvokePrePhysicsImpl(double dt, void** fieldArrayTable, uint3
         viewBatch.Advance(SIMD_BATCH);
     }
 
+    // A full last batch leaves no tail, its masked view would point one batch (a whole block) past the rows
+    if (componentCount % SIMD_BATCH == 0)
+        return;
+
     // perform the last batch with a mask.
     alignas(32) typename T::MaskedType tailBatch;
+    tailBatch.Reg = Reg;
     // Handle the tail with a mask
-    tailBatch.Hydrate(fieldArrayTable, SIMD_BATCH * batchCount, componentCount % SIMD_BATCH);
+    tailBatch.Hydrate(fieldArrayTable, SIMD_BATCH * batchCount, componentCount % SIMD_BATCH, blockStride);
     tailBatch.PrePhysics(dt);
     
 }
 
 template <typename T>
-__forceinline void InvokeUpdateImpl(double dt, void** fieldArrayTable, uint32_t componentCount)
+__forceinline void InvokeUpdateImpl(Registry* Reg, double dt, void** fieldArrayTable, uint32_t componentCount)
 {
     alignas(32) T viewBatch;
+    viewBatch.Reg = Reg;
+
+    const uint32_t blockStride = GetKernelBlockStride(componentCount);
+    componentCount = GetKernelRows(componentCount);
 
     constexpr uint32_t SIMD_BATCH = 8;
     const uint32_t batchCount = componentCount / SIMD_BATCH;
 
-    viewBatch.Hydrate(fieldArrayTable);
+    viewBatch.Hydrate(fieldArrayTable, 0, -1, blockStride);
 
     // Process batches
     for (uint32_t i = 0; i < batchCount; i++)
@@ -92,23 +209,31 @@ __forceinline void InvokeUpdateImpl(double dt, void** fieldArrayTable, uint32_t
         viewBatch.Advance(SIMD_BATCH);
     }
 
+    if (componentCount % SIMD_BATCH == 0)
+        return;
+
     STRIGID_ZONE_FINE_N("Tail Batch")
     // perform the last batch with a mask.
     alignas(32) typename T::MaskedType tailBatch;
+    tailBatch.Reg = Reg;
     // Handle the tail with a mask
-    tailBatch.Hydrate(fieldArrayTable, SIMD_BATCH * batchCount, componentCount % SIMD_BATCH);
+    tailBatch.Hydrate(fieldArrayTable, SIMD_BATCH * batchCount, componentCount % SIMD_BATCH, blockStride);
     tailBatch.Update(dt);
 }
 
 template <typename T>
-__forceinline void InvokePostPhysicsImpl(double dt, void** fieldArrayTable, uint32_t componentCount)
+__forceinline void InvokePostPhysicsImpl(Registry* Reg, double dt, void** fieldArrayTable, uint32_t componentCount)
 {
     alignas(32) T viewBatch;
+    viewBatch.Reg = Reg;
+
+    const uint32_t blockStride = GetKernelBlockStride(componentCount);
+    componentCount = GetKernelRows(componentCount);
 
     constexpr uint32_t SIMD_BATCH = 8;
     const uint32_t batchCount = componentCount / SIMD_BATCH;
 
-    viewBatch.Hydrate(fieldArrayTable);
+    viewBatch.Hydrate(fieldArrayTable, 0, -1, blockStride);
 
     // Process batches
     for (uint32_t i = 0; i < batchCount; i++)
@@ -117,14 +242,156 @@ __forceinline void InvokePostPhysicsImpl(double dt, void** fieldArrayTable, uint
         viewBatch.Advance(SIMD_BATCH);
     }
 
+    if (componentCount % SIMD_BATCH == 0)
+        return;
+
     STRIGID_ZONE_FINE_N("Tail Batch")
     // perform the last batch with a mask.
     alignas(32) typename T::MaskedType tailBatch;
+    tailBatch.Reg = Reg;
     // Handle the tail with a mask
-    tailBatch.Hydrate(fieldArrayTable, SIMD_BATCH * batchCount, componentCount % SIMD_BATCH);
+    tailBatch.Hydrate(fieldArrayTable, SIMD_BATCH * batchCount, componentCount % SIMD_BATCH, blockStride);
     tailBatch.PostPhysics(dt);
 }
 
+// Kernel for the hooks without arguments (OnCreate, OnDestroy, OnActivate, OnDeactivate), HookCall::Invoke calls the hook on a view
+template <typename T, typename HookCall>
+__forceinline void InvokeHookImpl(Registry* Reg, [[maybe_unused]] double dt, void** fieldArrayTable, uint32_t componentCount)
+{
+    alignas(32) T viewBatch;
+    viewBatch.Reg = Reg;
+
+    const uint32_t blockStride = GetKernelBlockStride(componentCount);
+    componentCount = GetKernelRows(componentCount);
+
+    constexpr uint32_t SIMD_BATCH = 8;
+    const uint32_t batchCount = componentCount / SIMD_BATCH;
+
+    viewBatch.Hydrate(fieldArrayTable, 0, -1, blockStride);
+
+    // Process batches
+    for (uint32_t i = 0; i < batchCount; i++)
+    {
+        HookCall::Invoke(viewBatch);
+        viewBatch.Advance(SIMD_BATCH);
+    }
+
+    if (componentCount % SIMD_BATCH == 0)
+        return;
+
+    // Handle the tail with a mask
+    alignas(32) typename T::MaskedType tailBatch;
+    tailBatch.Reg = Reg;
+    tailBatch.Hydrate(fieldArrayTable, SIMD_BATCH * batchCount, componentCount % SIMD_BATCH, blockStride);
+    HookCall::Invoke(tailBatch);
+}
+
+struct OnCreateCall
+{
+    template <typename V>
+    static __forceinline void Invoke(V& View) { View.OnCreate(); }
+};
+
+struct OnDestroyCall
+{
+    template <typename V>
+    static __forceinline void Invoke(V& View) { View.OnDestroy(); }
+};
+
+struct OnActivateCall
+{
+    template <typename V>
+    static __forceinline void Invoke(V& View) { View.OnActivate(); }
+};
+
+struct OnDeactivateCall
+{
+    template <typename V>
+    static __forceinline void Invoke(V& View) { View.OnDeactivate(); }
+};
+
+// Query kernel for Registry::ForEach, same batching as the lifecycle kernels but over bare components
+// TableIndices holds where each component's field arrays start in fieldArrayTable, blockStride as in PackKernelCount
+template <template <bool> class... Components, typename Fn>
+__forceinline void InvokeForEachImpl(Fn& Body, void** fieldArrayTable, const int32_t* TableIndices, uint32_t componentCount,
+                                     uint32_t blockStride = 0)
+{
+    constexpr uint32_t SIMD_BATCH = 8;
+    const uint32_t batchCount = componentCount / SIMD_BATCH;
+
+    std::tuple<Components<false>...> viewBatch;
+    std::apply([&](auto&... Views)
+    {
+        uint32_t i = 0;
+        (Views.Bind(&fieldArrayTable[TableIndices[i++]], 0, -1, blockStride), ...);
+    }, viewBatch);
+
+    // Process batches
+    for (uint32_t i = 0; i < batchCount; i++)
+    {
+        std::apply([&](auto&... Views)
+        {
+            Body(Views...);
+            (Views.Advance(SIMD_BATCH), ...);
+        }, viewBatch);
+    }
+
+    const int32_t tailCount = static_cast<int32_t>(componentCount % SIMD_BATCH);
+    if (tailCount == 0)
+        return;
+
+    STRIGID_ZONE_FINE_N("Tail Batch")
+    // Handle the tail with a mask
+    std::tuple<Components<true>...> tailBatch;
+    std::apply([&](auto&... Views)
+    {
+        uint32_t i = 0;
+        (Views.Bind(&fieldArrayTable[TableIndices[i++]], SIMD_BATCH * batchCount, tailCount, blockStride), ...);
+        Body(Views...);
+    }, tailBatch);
+}
+
+// Predicate kernel for Registry::DestroyWhere: Body(Views...) returns a lane mask per batch (bit i = row i matches),
+// written to OutMasks one byte per batch with the tail's dead lanes cleared
+template <template <bool> class... Components, typename Fn>
+__forceinline void InvokePredicateImpl(Fn& Body, void** fieldArrayTable, const int32_t* TableIndices,
+                                       uint32_t componentCount, uint8_t* OutMasks, uint32_t blockStride = 0)
+{
+    constexpr uint32_t SIMD_BATCH = 8;
+    const uint32_t batchCount = componentCount / SIMD_BATCH;
+
+    std::tuple<Components<false>...> viewBatch;
+    std::apply([&](auto&... Views)
+    {
+        uint32_t i = 0;
+        (Views.Bind(&fieldArrayTable[TableIndices[i++]], 0, -1, blockStride), ...);
+    }, viewBatch);
+
+    for (uint32_t i = 0; i < batchCount; i++)
+    {
+        std::apply([&](auto&... Views)
+        {
+            OutMasks[i] = static_cast<uint8_t>(Body(Views...));
+            (Views.Advance(SIMD_BATCH), ...);
+        }, viewBatch);
+    }
+
+    const int32_t tailCount = static_cast<int32_t>(componentCount % SIMD_BATCH);
+    if (tailCount == 0)
+        return;
+
+    std::tuple<Components<true>...> tailBatch;
+    std::apply([&](auto&... Views)
+    {
+        uint32_t i = 0;
+        (Views.Bind(&fieldArrayTable[TableIndices[i++]], SIMD_BATCH * batchCount, tailCount, blockStride), ...);
+        OutMasks[batchCount] = static_cast<uint8_t>(Body(Views...) & ((1u << tailCount) - 1));
+    }, tailBatch);
+}
+
+// Upper bound on entity classes, one per value of EntityID::TypeID
+static constexpr size_t MAX_ENTITY_CLASSES = size_t{1} << EntityIDLayout::TYPE_BITS;
+
 class MetaRegistry
 {
 public:
@@ -137,7 +404,8 @@ public:
     std::unordered_map<ClassID, ComponentSignature> ClassToArchetype;
     std::unordered_map<ClassID, std::vector<ComponentTypeID>> ClassToComponentList;
     std::unordered_map<Signature, std::vector<ClassID>> ArchetypeToClass;
-    EntityMeta EntityGetters[4096];
+    std::unordered_map<ClassID, std::vector<FieldDefault>> ClassToDefaults;
+    EntityMeta EntityGetters[MAX_ENTITY_CLASSES];
 
     template <typename T>
     void RegisterPrefab()
@@ -162,6 +430,43 @@ public:
             // Then in RegisterEntity:
             EntityGetters[ID].PostPhys = InvokePostPhysicsImpl<T>;
         }
+
+        if constexpr (HasOnCreate<T>)
+        {
+            EntityGetters[ID].OnCreate = InvokeHookImpl<T, OnCreateCall>;
+        }
+
+        if constexpr (HasOnDestroy<T>)
+        {
+            EntityGetters[ID].OnDestroy = InvokeHookImpl<T, OnDestroyCall>;
+        }
+
+        if constexpr (HasOnActivate<T>)
+        {
+            EntityGetters[ID].OnActivate = InvokeHookImpl<T, OnActivateCall>;
+        }
+
+        if constexpr (HasOnDeactivate<T>)
+        {
+            EntityGetters[ID].OnDeactivate = InvokeHookImpl<T, OnDeactivateCall>;
+        }
+
+        if constexpr (HasTransientLifetime<T>)
+        {
+            EntityGetters[ID].TransientLifetime = T::TransientLifetime;
+        }
+
+        if constexpr (HasBlockedLayout<T>)
+        {
+            EntityGetters[ID].bBlockedLayout = true;
+        }
+
+        if constexpr (HasDefineDefaults<T>)
+        {
+            PrefabDefaults Defaults;
+            T::DefineDefaults(Defaults);
+            ClassToDefaults[ID] = std::move(Defaults.Fields);
+        }
     }
 
     template <typename C, typename T>
@@ -170,7 +475,7 @@ public:
         const ClassID ID = C::StaticClassID();
         const ComponentTypeID TypeID = GetComponentTypeID<T>();
         ComponentSignature& Def = ClassToArchetype[ID];
-        Def |= 1 << (TypeID - 1);
+        Def.set(TypeID - 1);
         
         ClassToComponentList[ID].push_back(TypeID);
     }
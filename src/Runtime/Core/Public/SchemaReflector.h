@@ -1,5 +1,6 @@
 #pragma once
 #include <array>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
 
@@ -112,6 +113,47 @@ static constexpr size_t GetFieldCount()
     return std::tuple_size_v<decltype(Derived::DefineFields())>;
 }
 
+// Static registration for tag components (see STRIGID_TAG_COMPONENT)
+template <typename Derived>
+static bool RegisterTagStatic()
+{
+    ComponentFieldRegistry::Get().RegisterTag(GetComponentTypeID<Derived>());
+    return true;
+}
+
+// Static registration for shared components (see STRIGID_REGISTER_SHARED_COMPONENT)
+template <typename Derived>
+static bool RegisterSharedStatic()
+{
+    VALIDATE_COMPONENT_IS_POD(Derived);
+    static_assert(alignof(Derived) <= 8, "Shared component values are stored with 8 byte alignment");
+
+    ComponentFieldRegistry::Get().RegisterShared(GetComponentTypeID<Derived>(), sizeof(Derived), alignof(Derived));
+    return true;
+}
+
+// Static registration for sparse-set components (see STRIGID_REGISTER_SPARSE_COMPONENT)
+template <typename Derived>
+static bool RegisterSparseStatic()
+{
+    VALIDATE_COMPONENT_IS_POD(Derived);
+    ComponentFieldRegistry::Get().RegisterSparse(GetComponentTypeID<Derived>(), sizeof(Derived), alignof(Derived));
+    return true;
+}
+
+// Index of a named field in a component's field list (matches the field array order), usable at compile time
+// Returns the field count if the name doesn't exist
+template <typename Derived>
+static constexpr uint32_t FieldIndexOf(std::string_view Name)
+{
+    for (uint32_t i = 0; i < Derived::FieldNames.size(); ++i)
+    {
+        if (Name == Derived::FieldNames[i])
+            return i;
+    }
+    return static_cast<uint32_t>(Derived::FieldNames.size());
+}
+
 // Static registration - called once during static initialization
 template <typename Derived>
 static bool RegisterFieldsStatic()
@@ -201,6 +243,7 @@ __forceinline void ForEachField(Func&& func)
 #define STRIGID_MAP_15(m, c, x, ...) m(c, x), STRIGID_MAP_14(m, c, __VA_ARGS__)
 #define STRIGID_MAP_16(m, c, x, ...) m(c, x), STRIGID_MAP_15(m, c, __VA_ARGS__)
 
+#define STRIGID_MAPF_1(m, c, x)      m(c, x)
 #define STRIGID_MAPF_2(m, c, x, ...) m(c, x) STRIGID_MAP_1(m, c, __VA_ARGS__)
 #define STRIGID_MAPF_3(m, c, x, ...) m(c, x) STRIGID_MAPF_2(m, c, __VA_ARGS__)
 #define STRIGID_MAPF_4(m, c, x, ...) m(c, x) STRIGID_MAPF_3(m, c, __VA_ARGS__)
@@ -233,7 +276,7 @@ __forceinline void ForEachField(Func&& func)
 
 #define STRIGID_BIND_FINAL(ComponentType, Member, ...) Member.MaskFinal(count);
 
-#define STRIGID_BIND_BIND(ComponentType, Member, ...) Member.Bind(arrays[arrayIndex++], startIndex, count);
+#define STRIGID_BIND_BIND(ComponentType, Member, ...) Member.Bind(arrays[arrayIndex++], startIndex, count, blockStride);
 
 // Handles creating the field definition, debug field names, Bind function, and Registering the struct component
 #define STRIGID_REGISTER_FIELDS(ComponentType, ...) \
@@ -251,7 +294,7 @@ __forceinline void ForEachField(Func&& func)
         __VA_OPT__(STRIGID_MAPF_LIST(STRIGID_BIND_ADVANCE, ComponentType, __VA_ARGS__)) \
     } \
 \
-    __forceinline void Bind(void** arrays, uint32_t startIndex = 0, int32_t count = -1) \
+    __forceinline void Bind(void** arrays, uint32_t startIndex = 0, int32_t count = -1, uint32_t blockStride = 0) \
     { \
         int32_t arrayIndex = 0; \
         __VA_OPT__(STRIGID_MAPF_LIST(STRIGID_BIND_BIND, ComponentType, __VA_ARGS__)) \
@@ -262,5 +305,40 @@ __forceinline void ForEachField(Func&& func)
         static bool _##ComponentType##_FieldsRegistered = RegisterFieldsStatic<ComponentType<>>(); \
     }
 
+// Declares and registers a zero-size tag component, e.g. STRIGID_TAG_COMPONENT(Burning)
+// Tags only set their signature bit: they take part in archetype matching and queries but get no field
+// arrays, so they cost no chunk bytes and filtering by them costs nothing per row
+#define STRIGID_TAG_COMPONENT(TagType) \
+    template <bool MASK = false> \
+    struct TagType : public ComponentView<TagType<MASK>, MASK> \
+    { \
+        static constexpr bool bTagComp = true; \
+        __forceinline void Advance(uint32_t) {} \
+        __forceinline void Bind(void**, uint32_t = 0, int32_t = -1, uint32_t = 0) {} \
+    }; \
+    namespace { \
+        static bool _##TagType##_TagRegistered = RegisterTagStatic<TagType<>>(); \
+    }
+
+// Registers a plain POD struct as a shared component, e.g. struct RenderMesh { uint32_t MeshID; };
+// Every entity in a chunk has the same value, stored once (see Registry::SetShared). Entities are
+// grouped into chunks by value, so iterating chunks also groups them by value
+#define STRIGID_REGISTER_SHARED_COMPONENT(ComponentType) \
+    template <> \
+    struct SharedComponentTrait<ComponentType> : std::true_type {}; \
+    namespace { \
+        static bool _##ComponentType##_SharedRegistered = RegisterSharedStatic<ComponentType>(); \
+    }
+
+// Registers a plain POD struct as a sparse-set component, e.g. struct Stunned { float TimeLeft; };
+// Attached with Registry::AddSparse without moving the entity between archetypes, for components
+// that are rare or toggled often (status effects, buffs...)
+#define STRIGID_REGISTER_SPARSE_COMPONENT(ComponentType) \
+    template <> \
+    struct SparseComponentTrait<ComponentType> : std::true_type {}; \
+    namespace { \
+        static bool _##ComponentType##_SparseRegistered = RegisterSparseStatic<ComponentType>(); \
+    }
+
 #define STRIGID_HOT_COMPONENT() \
     alignas(4) static inline bool bHotComp = true;
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+
+#include "EngineConfig.h"
+#include "Registry.h"
+
+/**
+ * SimulationWorld: An isolated Registry with its own fixed-step clock
+ *
+ * Type metadata (MetaRegistry, ComponentFieldRegistry) is process-wide and immutable after
+ * static init, so any number of worlds share it. Entities, archetypes, chunks, history and
+ * the accumulator belong to the world.
+ *
+ * StepAll advances a set of worlds in parallel, one job per world. Chunk dispatch inside a
+ * world job runs inline on that worker, so small worlds don't fight over the pool.
+ */
+class SimulationWorld
+{
+public:
+    explicit SimulationWorld(const EngineConfig& Config);
+    ~SimulationWorld() = default;
+    SimulationWorld(const SimulationWorld&) = delete;
+    SimulationWorld& operator=(const SimulationWorld&) = delete;
+
+    Registry& GetRegistry() { return WorldRegistry; }
+    const EngineConfig& GetConfig() const { return WorldConfig; }
+
+    // Advance by dt of wall time: as many fixed steps as the accumulator allows, then Update(dt)
+    // Returns the number of fixed steps taken
+    uint32_t Advance(double dt);
+
+    // Advance every world by dt in parallel on the job system
+    static void StepAll(SimulationWorld* const* Worlds, uint32_t WorldCount, double dt);
+
+    double GetSimulationTime() const { return SimulationTime; }
+    double GetAccumulator() const { return Accumulator; }
+    uint64_t GetFixedStepCount() const { return FixedStepCount; }
+    uint64_t GetStateChecksum() const { return StateChecksum; } // After the last fixed step
+
+private:
+    EngineConfig WorldConfig; // Must be declared before WorldRegistry, the Registry reads it on construction
+    Registry WorldRegistry;
+
+    // Timing
+    double FixedStepTime;
+    double Accumulator = 0.0;
+    double SimulationTime = 0.0;
+    uint64_t FixedStepCount = 0;
+    uint64_t StateChecksum = 0;
+};
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <functional>
 #include <cmath>
+#include <type_traits>
 
 // Disable MSVC warning for anonymous structs in unions (C++11 standard feature)
 #ifdef _MSC_VER
@@ -76,6 +77,44 @@ ComponentTypeID GetComponentTypeID()
     return id;
 }
 
+// EntityID bit layout, set at compile time (e.g. -DSTRIGID_ENTITY_INDEX_BITS=26 for large server shards)
+// MetaFlags gets whatever the other fields and IsStatic leave of the 64 bits
+#ifndef STRIGID_ENTITY_INDEX_BITS
+#define STRIGID_ENTITY_INDEX_BITS 24 // 16M entities (array slot)
+#endif
+#ifndef STRIGID_ENTITY_GENERATION_BITS
+#define STRIGID_ENTITY_GENERATION_BITS 16 // 65k recycles (server-grade stability)
+#endif
+#ifndef STRIGID_ENTITY_TYPE_BITS
+#define STRIGID_ENTITY_TYPE_BITS 12 // 4k class types (function dispatch)
+#endif
+#ifndef STRIGID_ENTITY_OWNER_BITS
+#define STRIGID_ENTITY_OWNER_BITS 8 // 256 owners (network routing)
+#endif
+
+namespace EntityIDLayout
+{
+    constexpr uint32_t INDEX_BITS = STRIGID_ENTITY_INDEX_BITS;
+    constexpr uint32_t GENERATION_BITS = STRIGID_ENTITY_GENERATION_BITS;
+    constexpr uint32_t TYPE_BITS = STRIGID_ENTITY_TYPE_BITS;
+    constexpr uint32_t OWNER_BITS = STRIGID_ENTITY_OWNER_BITS;
+    constexpr uint32_t META_BITS = 64 - INDEX_BITS - GENERATION_BITS - TYPE_BITS - OWNER_BITS - 1;
+
+    constexpr uint32_t GENERATION_MASK = (1u << GENERATION_BITS) - 1;
+
+    // Indices are handed out as uint32_t and the index table needs one past the last index
+    static_assert(INDEX_BITS >= 12 && INDEX_BITS <= 31, "Entity index must be 12 to 31 bits");
+    // Batched lookups use UINT32_MAX as a generation no ID can have
+    static_assert(GENERATION_BITS >= 1 && GENERATION_BITS <= 31, "Entity generation must be 1 to 31 bits");
+    static_assert(TYPE_BITS >= 1 && TYPE_BITS <= 16, "Entity type must fit a ClassID");
+    static_assert(OWNER_BITS >= 1 && OWNER_BITS <= 8, "Entity owner must fit a uint8_t");
+    static_assert(INDEX_BITS + GENERATION_BITS + TYPE_BITS + OWNER_BITS + 1 < 64,
+                  "EntityID fields overflow 64 bits (MetaFlags needs at least one)");
+}
+
+// Smallest unsigned type that holds a generation
+using EntityGeneration = std::conditional_t<(EntityIDLayout::GENERATION_BITS <= 16), uint16_t, uint32_t>;
+
 // EntityID - 64-bit smart handle with embedded metadata
 // Swappable design: Implement GetIndex(), IsValid(), operator== for custom implementations
 union EntityID
@@ -85,17 +124,17 @@ union EntityID
     // Bitfield layout
     struct
     {
-        uint64_t Index : 20; // 1 Million entities (array slot)
-        uint64_t Generation : 16; // 65k recycles (server-grade stability)
-        uint64_t TypeID : 12; // 4k class types (function dispatch)
-        uint64_t OwnerID : 8; // 256 owners (network routing)
+        uint64_t Index : EntityIDLayout::INDEX_BITS;
+        uint64_t Generation : EntityIDLayout::GENERATION_BITS;
+        uint64_t TypeID : EntityIDLayout::TYPE_BITS;
+        uint64_t OwnerID : EntityIDLayout::OWNER_BITS;
         uint64_t IsStatic : 1; // Static Entity Flag
-        uint64_t MetaFlags : 7; // Reserved for future use
+        uint64_t MetaFlags : EntityIDLayout::META_BITS; // Reserved for future use
     };
 
     // Required interface (for swappability)
     uint32_t GetIndex() const { return static_cast<uint32_t>(Index); }
-    uint16_t GetGeneration() const { return static_cast<uint16_t>(Generation); }
+    EntityGeneration GetGeneration() const { return static_cast<EntityGeneration>(Generation); }
     uint16_t GetTypeID() const { return static_cast<uint16_t>(TypeID); }
     uint8_t GetOwnerID() const { return static_cast<uint8_t>(OwnerID); }
     bool GetIsStatic() const { return IsStatic; }
@@ -118,6 +157,11 @@ union EntityID
     bool IsLocal(uint8_t LocalClientID) const { return OwnerID == LocalClientID; }
 };
 
+static_assert(sizeof(EntityID) == sizeof(uint64_t), "EntityID must stay a 64-bit handle");
+
+// Row within a chunk, sized by how many rows a chunk can hold (every row stores at least its EntityID)
+using ChunkRow = std::conditional_t<(CHUNK_SIZE / sizeof(EntityID) <= UINT16_MAX), uint16_t, uint32_t>;
+
 // Instance data format for GPU upload
 // Aligned to 16 bytes for SIMD vectorization and GPU alignment
 struct alignas(16) InstanceData
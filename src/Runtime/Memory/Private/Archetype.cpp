@@ -1,69 +1,346 @@
 #include "../Public/Archetype.h"
 #include "Profiler.h"
+#include "ChunkAllocator.h"
 #include <cassert>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <immintrin.h>
 #include <FieldMeta.h>
 
+namespace
+{
+    // Left-pack permutations for _mm256_permutevar8x32_epi32, entry Mask moves the lanes set in Mask to the front
+    struct PackTables
+    {
+        alignas(32) uint32_t Lanes32[256][8]; // 8 x 4-byte elements
+        alignas(32) uint32_t Lanes64[16][8]; // 4 x 8-byte elements, as pairs of 32-bit lanes
+    };
+
+    constexpr PackTables BuildPackTables()
+    {
+        PackTables Tables{};
+        for (uint32_t Mask = 0; Mask < 256; ++Mask)
+        {
+            uint32_t Out = 0;
+            for (uint32_t Lane = 0; Lane < 8; ++Lane)
+            {
+                if (Mask & (1u << Lane))
+                    Tables.Lanes32[Mask][Out++] = Lane;
+            }
+        }
+        for (uint32_t Mask = 0; Mask < 16; ++Mask)
+        {
+            uint32_t Out = 0;
+            for (uint32_t Lane = 0; Lane < 4; ++Lane)
+            {
+                if (Mask & (1u << Lane))
+                {
+                    Tables.Lanes64[Mask][Out++] = Lane * 2;
+                    Tables.Lanes64[Mask][Out++] = Lane * 2 + 1;
+                }
+            }
+        }
+        return Tables;
+    }
+
+    constexpr PackTables PACK_TABLES = BuildPackTables();
+
+    // Move the lanes set in Keep of 8 contiguous elements to the front of Dst, as whole registers (32 or 64 bytes)
+    void PackLanes(const uint8_t* Src, uint32_t Keep, size_t ElementSize, uint8_t* Dst)
+    {
+        if (ElementSize == 4)
+        {
+            const __m256i Values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Src));
+            const __m256i Lanes = _mm256_load_si256(reinterpret_cast<const __m256i*>(PACK_TABLES.Lanes32[Keep]));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(Dst), _mm256_permutevar8x32_epi32(Values, Lanes));
+            return;
+        }
+
+        const __m256i Low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Src));
+        const __m256i High = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Src + 32));
+        const uint32_t LowKeep = Keep & 0xF;
+        const uint32_t HighKeep = Keep >> 4;
+        const __m256i LowLanes = _mm256_load_si256(reinterpret_cast<const __m256i*>(PACK_TABLES.Lanes64[LowKeep]));
+        const __m256i HighLanes = _mm256_load_si256(reinterpret_cast<const __m256i*>(PACK_TABLES.Lanes64[HighKeep]));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(Dst), _mm256_permutevar8x32_epi32(Low, LowLanes));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(Dst + std::popcount(LowKeep) * 8),
+                            _mm256_permutevar8x32_epi32(High, HighLanes));
+    }
+
+    // Left-pack one column of a dense archetype (see Archetype::CompactRows), returns the surviving row count
+    // Registers are stored whole, the lanes past the kept ones land on rows already read. BlockStride is the
+    // archetype's (0 for SoA columns), a batch is then one block's run and runs of other fields sit past it
+    uint32_t PackColumn(const std::vector<Chunk*>& Chunks, size_t Offset, size_t ElementSize, uint32_t EntitiesPerChunk,
+                        uint32_t RowCount, const uint8_t* DoomedMasks, size_t BlockStride)
+    {
+        auto Element = [&](uint32_t ChunkIdx, uint32_t Local)
+        {
+            const size_t RowOffset = BlockStride ? (Local / 8) * BlockStride + (Local % 8) * ElementSize
+                                                 : Local * ElementSize;
+            return Chunks[ChunkIdx]->Data + Offset + RowOffset;
+        };
+
+        const uint32_t BatchesPerChunk = (EntitiesPerChunk + 7) / 8;
+        uint32_t DstChunk = 0;
+        uint32_t DstLocal = 0;
+        uint32_t Dst = 0;
+        auto AdvanceDst = [&](uint32_t Rows)
+        {
+            Dst += Rows;
+            DstLocal += Rows;
+            if (DstLocal >= EntitiesPerChunk)
+            {
+                DstLocal -= EntitiesPerChunk;
+                ++DstChunk;
+            }
+        };
+
+        for (uint32_t ChunkIdx = 0; ChunkIdx * EntitiesPerChunk < RowCount; ++ChunkIdx)
+        {
+            const uint8_t* Masks = DoomedMasks + ChunkIdx * BatchesPerChunk;
+            const uint32_t ChunkRows = std::min(RowCount - ChunkIdx * EntitiesPerChunk, EntitiesPerChunk);
+            for (uint32_t Local = 0; Local < ChunkRows; Local += 8)
+            {
+                const uint32_t LiveLanes = (1u << std::min(ChunkRows - Local, 8u)) - 1;
+                const uint32_t Keep = ~Masks[Local / 8] & LiveLanes;
+
+                // Nothing removed yet, the batch stays where it is
+                if (Keep == LiveLanes && DstChunk == ChunkIdx && DstLocal == Local)
+                {
+                    AdvanceDst(std::popcount(LiveLanes));
+                    continue;
+                }
+                if (Keep == 0)
+                    continue;
+
+                const uint8_t* Src = Element(ChunkIdx, Local);
+                const bool bVector = ElementSize == 4 || ElementSize == 8;
+                const bool bWholeRegisters = bVector && (BlockStride ? DstLocal % 8 == 0
+                                                                     : Local + 8 <= EntitiesPerChunk &&
+                                                                       DstLocal + 8 <= EntitiesPerChunk);
+                if (bWholeRegisters)
+                {
+                    PackLanes(Src, Keep, ElementSize, Element(DstChunk, DstLocal));
+                    AdvanceDst(std::popcount(Keep));
+                }
+                else if (bVector && BlockStride)
+                {
+                    // Destination starts mid-block: pack aside, then split the run at the block's end
+                    alignas(32) uint8_t Packed[64];
+                    PackLanes(Src, Keep, ElementSize, Packed);
+                    const uint32_t Kept = std::popcount(Keep);
+                    const uint32_t First = std::min(Kept, 8 - DstLocal % 8);
+                    std::memcpy(Element(DstChunk, DstLocal), Packed, First * ElementSize);
+                    AdvanceDst(First);
+                    if (Kept > First)
+                    {
+                        std::memcpy(Element(DstChunk, DstLocal), Packed + First * ElementSize, (Kept - First) * ElementSize);
+                        AdvanceDst(Kept - First);
+                    }
+                }
+                else
+                {
+                    // Other element sizes, chunk edges
+                    for (uint32_t Bits = Keep; Bits; Bits &= Bits - 1)
+                    {
+                        std::memmove(Element(DstChunk, DstLocal), Src + std::countr_zero(Bits) * ElementSize, ElementSize);
+                        AdvanceDst(1);
+                    }
+                }
+            }
+        }
+        return Dst;
+    }
+}
+
 Archetype::Archetype(const Signature& Sig, const ClassID& ID, const char* DebugName)
     : ArchSignature(Sig)
       , ArchClassID(ID)
       , DebugName(DebugName)
+      , PendingChunks(std::make_unique<std::atomic<Chunk*>[]>(MAX_PENDING_CHUNKS))
 {
 }
 
 Archetype::Archetype(const ArchetypeKey& ArchKey, const char* DebugName)
-    : ArchSignature(ArchKey.Sig)
-      , ArchClassID(ArchKey.ID)
-      , DebugName(DebugName)
+    : Archetype(ArchKey.Sig, ArchKey.ID, DebugName)
 {
+    SharedSet = ArchKey.SharedSet;
+    bDormant = ArchKey.Dormant;
 }
 
 Archetype::~Archetype()
 {
     // Clean up all allocated chunks
+    Clear();
+}
+
+void Archetype::Clear()
+{
+    ReleasePendingChunks();
+
     for (Chunk* ChunkPtr : Chunks)
     {
+        if (!ChunkPtr)
+            continue; // Paged out, the registry drops its pages
+
         // Tracy memory profiling: Track chunk deallocation with pool name
         STRIGID_FREE_N(ChunkPtr, DebugName);
-        delete ChunkPtr;
+        ChunkAllocator::Get().Free(ChunkPtr);
     }
     Chunks.clear();
+    PagedChunks.clear();
+    TotalEntityCount = 0;
+
+    for (Chunk* Spare : RingSpares)
+    {
+        STRIGID_FREE_N(Spare, DebugName);
+        ChunkAllocator::Get().Free(Spare);
+    }
+    RingSpares.clear();
+    HeadRow = 0;
+    ExpiredRows = 0;
+    SpawnMarks.clear();
+    IssuedIdCount = 0;
+    ClassRuns.clear();
+    bClassRunsDirty = false;
+}
+
+bool Archetype::BuildBlockedLayout(const std::vector<ComponentMetaEx>& Components)
+{
+    // Every stored component has to decompose into power of two fields of at most 8 bytes
+    struct BlockField
+    {
+        ComponentTypeID TypeID;
+        uint32_t FieldIndex;
+        const FieldMeta* Meta;
+    };
+
+    std::vector<BlockField> Fields;
+    for (const ComponentMetaEx& Meta : Components)
+    {
+        if (Meta.IsTag || Meta.IsShared)
+            continue;
+
+        const std::vector<FieldMeta>* ComponentFields = ComponentFieldRegistry::Get().GetFields(Meta.TypeID);
+        if (!ComponentFields || ComponentFields->empty())
+            return false;
+
+        for (size_t FieldIdx = 0; FieldIdx < ComponentFields->size(); ++FieldIdx)
+        {
+            const FieldMeta& Field = (*ComponentFields)[FieldIdx];
+            if (Field.Size == 0 || Field.Size > 8 || !std::has_single_bit(Field.Size))
+                return false;
+            Fields.push_back({Meta.TypeID, static_cast<uint32_t>(FieldIdx), &Field});
+        }
+    }
+    if (Fields.empty())
+        return false;
+
+    // One block: each field's BLOCK_ROWS elements back to back, runs aligned for whole register loads
+    std::vector<size_t> RunOffsets;
+    size_t BlockBytes = 0;
+    for (const BlockField& Field : Fields)
+    {
+        const size_t RunBytes = BLOCK_ROWS * Field.Meta->Size;
+        BlockBytes = AlignOffset(BlockBytes, std::min<size_t>(RunBytes, 32));
+        RunOffsets.push_back(BlockBytes);
+        BlockBytes += RunBytes;
+    }
+    const size_t Stride = AlignOffset(BlockBytes, 64);
+
+    // ID column first, then whole blocks, 32 bytes spare for the full width loads of a tail batch
+    const size_t UsableSpace = Chunk::DATA_SIZE - Chunk::HEADER_SIZE - 32;
+    uint32_t Rows = static_cast<uint32_t>(UsableSpace / (sizeof(EntityID) + Stride / BLOCK_ROWS));
+    Rows -= Rows % BLOCK_ROWS;
+    if (Rows < BLOCK_ROWS)
+        return false;
+
+    EntitiesPerChunk = Rows;
+    BlockStride = Stride;
+    const size_t BlocksOffset = AlignOffset(Chunk::HEADER_SIZE + Rows * sizeof(EntityID), 64);
+
+    CachedFieldArrayLayout.clear();
+    FieldArrayTemplateCache.clear();
+    for (size_t i = 0; i < Fields.size(); ++i)
+    {
+        const size_t Offset = BlocksOffset + RunOffsets[i];
+        FieldOffsets[FieldKey{Fields[i].TypeID, Fields[i].FieldIndex}] = Offset;
+        CachedFieldArrayLayout.push_back({Fields[i].TypeID, Fields[i].FieldIndex, true});
+        FieldArrayTemplateCache.push_back({Offset, Fields[i].Meta->Size, Fields[i].Meta->Name});
+    }
+    TotalFieldArrayCount = Fields.size();
+    TotalChunkDataSize = BlocksOffset + (Rows / BLOCK_ROWS) * Stride;
+
+    LOG_INFO_F("Archetype layout: %zu field arrays in blocks of %u rows (%zu bytes), %zu bytes, %u entities/chunk",
+               TotalFieldArrayCount, BLOCK_ROWS, BlockStride, TotalChunkDataSize, EntitiesPerChunk);
+    assert(TotalChunkDataSize + 32 <= Chunk::DATA_SIZE);
+    assert(PackKernelCount(EntitiesPerChunk, BlockStride) >> KERNEL_ROW_BITS == BlockStride);
+    return true;
 }
 
 void Archetype::BuildLayout(const std::vector<ComponentMetaEx>& Components)
 {
+    BlockStride = 0;
+    if (bBlocked)
+    {
+        if (BuildBlockedLayout(Components))
+            return;
+
+        LOG_WARN_F("%s can't be blocked (needs field-decomposed components of 1, 2, 4 or 8 byte fields), kept SoA",
+                   DebugName);
+        bBlocked = false;
+    }
+
     if (Components.empty())
     {
         // Empty archetype - set a reasonable default capacity
         // (Useful for entities with only script component, no data components)
-        constexpr size_t ReservedHeaderSpace = 64;
-        size_t UsableSpace = Chunk::DATA_SIZE - ReservedHeaderSpace;
+        size_t UsableSpace = Chunk::DATA_SIZE - Chunk::HEADER_SIZE;
         EntitiesPerChunk = static_cast<uint32_t>(UsableSpace / 64); // Assume 64 bytes per entity minimum
+        TotalChunkDataSize = Chunk::HEADER_SIZE + EntitiesPerChunk * sizeof(EntityID);
         return;
     }
 
-    // Calculate total stride (sum of all component sizes)
-    size_t TotalStride = 0;
+    // Calculate total stride (sum of all component sizes + the entity ID column)
+    size_t TotalStride = sizeof(EntityID);
 
     for (const ComponentMetaEx& Meta : Components)
     {
-        TotalStride += Meta.Size;
+        // Shared components are stored once per chunk set, not per row
+        TotalStride += Meta.IsShared ? 0 : Meta.Size;
     }
 
     // Calculate how many entities fit in a chunk
-    // Reserve some space for potential chunk header in future
-    constexpr size_t ReservedHeaderSpace = 64;
-    size_t UsableSpace = Chunk::DATA_SIZE - ReservedHeaderSpace;
+    // First HEADER_SIZE bytes of every chunk hold the ChunkHeader
+    size_t UsableSpace = Chunk::DATA_SIZE - Chunk::HEADER_SIZE;
 
-    if (TotalStride > 0)
-    {
-        EntitiesPerChunk = static_cast<uint32_t>(UsableSpace / TotalStride);
-    }
-    else
+    // Worst case padding between arrays, each field array may need realigning
+    size_t AlignmentSlack = 0;
+    for (const ComponentMetaEx& Meta : Components)
     {
-        EntitiesPerChunk = static_cast<uint32_t>(UsableSpace / 64); // Minimum 64 bytes per entity
+        if (Meta.IsTag || Meta.IsShared)
+            continue;
+
+        const std::vector<FieldMeta>* fields = ComponentFieldRegistry::Get().GetFields(Meta.TypeID);
+        if (fields && !fields->empty())
+        {
+            for (const FieldMeta& field : *fields)
+            {
+                AlignmentSlack += field.Alignment - 1;
+            }
+        }
+        else
+        {
+            AlignmentSlack += Meta.Alignment - 1;
+        }
     }
+    UsableSpace -= AlignmentSlack;
 
-    size_t currentOffset = ReservedHeaderSpace;
+    EntitiesPerChunk = static_cast<uint32_t>(UsableSpace / TotalStride);
+
+    // Entity ID column first, field arrays after
+    size_t currentOffset = Chunk::HEADER_SIZE + EntitiesPerChunk * sizeof(EntityID);
 
     // Clear cached data
     CachedFieldArrayLayout.clear();
@@ -72,6 +349,10 @@ void Archetype::BuildLayout(const std::vector<ComponentMetaEx>& Components)
 
     for (const auto& comp : Components)
     {
+        // Tags only live in the signature, shared components in the SharedComponentStore
+        if (comp.IsTag || comp.IsShared)
+            continue;
+
         ComponentTypeID typeID = comp.TypeID;
 
         // Check if component has pre-registered field decomposition
@@ -105,6 +386,7 @@ void Archetype::BuildLayout(const std::vector<ComponentMetaEx>& Components)
                 // Add to template cache
                 FieldArrayTemplateCache.push_back({
                     currentOffset,
+                    field.Size,
                     field.Name
                 });
 
@@ -141,6 +423,7 @@ void Archetype::BuildLayout(const std::vector<ComponentMetaEx>& Components)
             // Add to template cache
             FieldArrayTemplateCache.push_back({
                 currentOffset,
+                comp.Size,
                 "non_decomposed"
             });
 
@@ -154,66 +437,580 @@ void Archetype::BuildLayout(const std::vector<ComponentMetaEx>& Components)
                TotalFieldArrayCount, TotalChunkDataSize, EntitiesPerChunk);
 
     // Validate cache consistency
+    assert(TotalChunkDataSize <= Chunk::DATA_SIZE);
     assert(CachedFieldArrayLayout.size() == TotalFieldArrayCount);
     assert(FieldArrayTemplateCache.size() == TotalFieldArrayCount);
 }
 
+void Archetype::BuildTemplateRow(const std::vector<FieldDefault>& Defaults)
+{
+    // Fields without a default are zero, a class without defaults gets an all-zero row
+    TemplateRow.assign(FieldArrayTemplateCache.size(), FieldFillPattern{});
+
+    for (const FieldDefault& Default : Defaults)
+    {
+        int32_t TableIndex = GetFieldTableIndex(Default.TypeID);
+        if (TableIndex < 0)
+            continue; // Component isn't stored in this archetype (tag, shared, sparse)
+
+        TableIndex += static_cast<int32_t>(Default.FieldIndex);
+        if (TableIndex >= static_cast<int32_t>(CachedFieldArrayLayout.size()) ||
+            !CachedFieldArrayLayout[TableIndex].isDecomposed ||
+            CachedFieldArrayLayout[TableIndex].componentID != Default.TypeID ||
+            FieldArrayTemplateCache[TableIndex].elementSize != Default.Size ||
+            sizeof(FieldFillPattern) % Default.Size != 0)
+        {
+            LOG_WARN_F("Default for component %u field %u doesn't match the field layout, ignored",
+                       Default.TypeID, Default.FieldIndex);
+            continue;
+        }
+
+        // Repeat the element across the pattern
+        const size_t ElementSize = Default.Size;
+        FieldFillPattern& Pattern = TemplateRow[TableIndex];
+        for (size_t Offset = 0; Offset < sizeof(Pattern.Bytes); Offset += ElementSize)
+        {
+            std::memcpy(Pattern.Bytes + Offset, &Default.Bits, ElementSize);
+        }
+    }
+}
+
+void Archetype::StampTemplateRows(Chunk* TargetChunk, uint32_t LocalIndex, uint32_t Count)
+{
+    if (TemplateRow.empty() || Count == 0)
+        return;
+
+    for (size_t i = 0; i < FieldArrayTemplateCache.size(); ++i)
+    {
+        const size_t ElementSize = FieldArrayTemplateCache[i].elementSize;
+        ForEachFieldRun(TargetChunk, i, LocalIndex, Count, [&](uint8_t* Dst, uint32_t Rows)
+        {
+            size_t Bytes = Rows * ElementSize;
+            if (32 % ElementSize != 0)
+            {
+                // Non-decomposed arrays can't carry defaults, they start zeroed
+                std::memset(Dst, 0, Bytes);
+                return;
+            }
+
+            // The pattern repeats every element, so 32 byte stores stay in phase from any row
+            const __m256i Pattern = _mm256_load_si256(reinterpret_cast<const __m256i*>(TemplateRow[i].Bytes));
+            for (; Bytes >= 32; Bytes -= 32, Dst += 32)
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(Dst), Pattern);
+            }
+            std::memcpy(Dst, TemplateRow[i].Bytes, Bytes);
+        });
+    }
+}
+
+void Archetype::StampTemplateRows(uint32_t FirstRow, uint32_t Count)
+{
+    if (TemplateRow.empty())
+        return;
+
+    while (Count > 0)
+    {
+        EntitySlot Slot = GetSlot(FirstRow);
+        const uint32_t Run = std::min(Count, EntitiesPerChunk - Slot.LocalIndex);
+        StampTemplateRows(Slot.TargetChunk, Slot.LocalIndex, Run);
+        FirstRow += Run;
+        Count -= Run;
+    }
+}
+
 uint32_t Archetype::GetChunkCount(size_t ChunkIndex) const
 {
     if (Chunks.empty() || ChunkIndex >= Chunks.size() || EntitiesPerChunk == 0)
         return 0;
 
-    // If it's the last chunk, calculate remainder
-    if (ChunkIndex == Chunks.size() - 1)
+    // Rows are dense from the head, every chunk but the last is full (dense packing invariant)
+    const uint32_t ChunkStart = static_cast<uint32_t>(ChunkIndex) * EntitiesPerChunk;
+    const uint32_t EndRow = HeadRow + TotalEntityCount;
+    if (EndRow <= ChunkStart)
+        return 0;
+
+    return std::min(EndRow - ChunkStart, EntitiesPerChunk) - GetChunkFirstRow(ChunkIndex);
+}
+
+void Archetype::ExpireRows(uint32_t Count)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    assert(bTransient && Count <= TotalEntityCount);
+
+    HeadRow += Count;
+    TotalEntityCount -= Count;
+    ExpiredRows += Count;
+
+    // Passed chunks rotate to the spare list, the remaining chunk pointers shift down once per chunk, not per row
+    uint32_t Passed = HeadRow / EntitiesPerChunk;
+    if (TotalEntityCount == 0)
+    {
+        Passed = static_cast<uint32_t>(Chunks.size());
+        HeadRow = 0;
+    }
+    else
+    {
+        HeadRow %= EntitiesPerChunk;
+    }
+
+    RingSpares.insert(RingSpares.end(), Chunks.begin(), Chunks.begin() + Passed);
+    Chunks.erase(Chunks.begin(), Chunks.begin() + Passed);
+}
+
+void Archetype::PageOutChunk(uint32_t ChunkIndex, std::vector<uint8_t>& OutPacked)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    Chunk* Src = Chunks[ChunkIndex];
+    const uint32_t Rows = GetChunkCount(ChunkIndex);
+
+    size_t RowBytes = sizeof(EntityID);
+    for (const FieldArrayTemplate& Field : FieldArrayTemplateCache)
+    {
+        RowBytes += Field.elementSize;
+    }
+    OutPacked.resize(Rows * RowBytes);
+
+    uint8_t* Cursor = OutPacked.data();
+    std::memcpy(Cursor, GetEntityIDs(Src), Rows * sizeof(EntityID));
+    Cursor += Rows * sizeof(EntityID);
+    for (size_t i = 0; i < FieldArrayTemplateCache.size(); ++i)
+    {
+        ForEachFieldRun(Src, i, 0, Rows, [&](const uint8_t* Elements, uint32_t RunRows)
+        {
+            std::memcpy(Cursor, Elements, RunRows * FieldArrayTemplateCache[i].elementSize);
+            Cursor += RunRows * FieldArrayTemplateCache[i].elementSize;
+        });
+    }
+
+    Chunks[ChunkIndex] = nullptr;
+    STRIGID_FREE_N(Src, DebugName);
+    ChunkAllocator::Get().Free(Src);
+}
+
+Chunk* Archetype::PageInChunk(uint32_t ChunkIndex, const std::vector<uint8_t>& Packed)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    Chunk* Dst = AllocateChunk();
+
+    size_t RowBytes = sizeof(EntityID);
+    for (const FieldArrayTemplate& Field : FieldArrayTemplateCache)
+    {
+        RowBytes += Field.elementSize;
+    }
+    const uint32_t Rows = static_cast<uint32_t>(Packed.size() / RowBytes);
+
+    const uint8_t* Cursor = Packed.data();
+    std::memcpy(GetEntityIDs(Dst), Cursor, Rows * sizeof(EntityID));
+    Cursor += Rows * sizeof(EntityID);
+    for (size_t i = 0; i < FieldArrayTemplateCache.size(); ++i)
     {
-        uint32_t Remainder = TotalEntityCount % EntitiesPerChunk;
-        // Handle case where last chunk is exactly full
-        return (Remainder == 0 && TotalEntityCount > 0) ? EntitiesPerChunk : Remainder;
+        ForEachFieldRun(Dst, i, 0, Rows, [&](uint8_t* Elements, uint32_t RunRows)
+        {
+            std::memcpy(Elements, Cursor, RunRows * FieldArrayTemplateCache[i].elementSize);
+            Cursor += RunRows * FieldArrayTemplateCache[i].elementSize;
+        });
     }
 
-    // All other chunks are guaranteed full (dense packing invariant)
-    return EntitiesPerChunk;
+    Chunks[ChunkIndex] = Dst;
+    PagedChunks.erase(ChunkIndex);
+    return Dst;
 }
 
-Archetype::EntitySlot Archetype::PushEntity()
+Archetype::EntitySlot Archetype::PushEntity(EntityID Id)
 {
     STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    EntitySlot Slot = GetSlot(PushEntities(1));
+    GetEntityIDs(Slot.TargetChunk)[Slot.LocalIndex] = Id;
+    return Slot;
+}
+
+uint32_t Archetype::PushEntities(uint32_t Count)
+{
     // Safety check for empty archetypes
     if (EntitiesPerChunk == 0)
     {
         EntitiesPerChunk = 256; // Default fallback
     }
 
-    // Check if we need a new chunk
+    const uint32_t FirstIndex = TotalEntityCount;
+    TotalEntityCount += Count;
+    bClassRunsDirty |= bMergedClasses;
+
+    // Allocate every chunk the new rows spill into up front
+    const size_t ChunksNeeded = (HeadRow + TotalEntityCount + EntitiesPerChunk - 1) / EntitiesPerChunk;
+    while (Chunks.size() < ChunksNeeded)
+    {
+        Chunks.push_back(AllocateChunk());
+    }
+
+    for (size_t ChunkIndex = (HeadRow + FirstIndex) / EntitiesPerChunk; ChunkIndex < ChunksNeeded; ++ChunkIndex)
+    {
+        MarkChanged(Chunks[ChunkIndex]);
+    }
+
+    return FirstIndex;
+}
+
+EntityID Archetype::RemoveEntity(uint32_t ChunkIndex, uint32_t LocalIndex)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    assert(TotalEntityCount > 0 && !bTransient);
+
+    const uint32_t LastIndex = TotalEntityCount - 1;
+    const uint32_t RemovedIndex = ChunkIndex * EntitiesPerChunk + LocalIndex;
+
+    EntityID Moved = EntityID::Invalid();
+    if (RemovedIndex != LastIndex)
+    {
+        // Swap: move the tail row into the hole
+        EntitySlot Tail = GetSlot(LastIndex);
+        Moved = GetEntityIDs(Tail.TargetChunk)[Tail.LocalIndex];
+        CopyRow(Tail.TargetChunk, Tail.LocalIndex, Chunks[ChunkIndex], LocalIndex);
+    }
+
+    // Pop
+    MarkChanged(Chunks.back());
+    TotalEntityCount--;
+    bClassRunsDirty |= bMergedClasses;
     if (TotalEntityCount % EntitiesPerChunk == 0)
     {
-        Chunk* NewChunk = AllocateChunk();
-        Chunks.push_back(NewChunk);
+        Chunk* EmptyChunk = Chunks.back();
+        Chunks.pop_back();
+        STRIGID_FREE_N(EmptyChunk, DebugName);
+        ChunkAllocator::Get().Free(EmptyChunk);
     }
 
-    // Calculate which chunk and local index
-    uint32_t ChunkIndex = TotalEntityCount / EntitiesPerChunk;
-    uint32_t LocalIndex = TotalEntityCount % EntitiesPerChunk;
+    return Moved;
+}
+
+uint32_t Archetype::ReservePendingRows(uint32_t Count)
+{
+    // CAS rather than an add, a reservation that doesn't fit leaves the cursor alone so every reserved row gets written
+    const uint32_t Capacity = MAX_PENDING_CHUNKS * EntitiesPerChunk;
+    uint32_t First = PendingRowCursor.load(std::memory_order_relaxed);
+    do
+    {
+        if (Count > Capacity - First)
+            return UINT32_MAX;
+    }
+    while (!PendingRowCursor.compare_exchange_weak(First, First + Count, std::memory_order_acq_rel));
+    return First;
+}
 
+Archetype::EntitySlot Archetype::GetPendingSlot(uint32_t PendingRow)
+{
     EntitySlot Slot;
-    Slot.TargetChunk = Chunks[ChunkIndex];
-    Slot.LocalIndex = LocalIndex;
-    Slot.GlobalIndex = TotalEntityCount;
+    Slot.ChunkIndex = PendingRow / EntitiesPerChunk;
+    Slot.LocalIndex = PendingRow % EntitiesPerChunk;
+    Slot.GlobalIndex = PendingRow;
 
-    TotalEntityCount++;
+    std::atomic<Chunk*>& Entry = PendingChunks[Slot.ChunkIndex];
+    Chunk* Pending = Entry.load(std::memory_order_acquire);
+    if (!Pending)
+    {
+        // Lock-free install, the loser hands its chunk straight back to the pool
+        ChunkAllocator& Allocator = ChunkAllocator::Get();
+        Chunk* NewChunk = Allocator.Allocate(Allocator.SelectNode(ArchClassID, Slot.ChunkIndex));
+        NewChunk->GetHeader().SharedSet = SharedSet;
+        if (Entry.compare_exchange_strong(Pending, NewChunk, std::memory_order_acq_rel))
+        {
+            Pending = NewChunk;
+        }
+        else
+        {
+            Allocator.Free(NewChunk);
+        }
+    }
 
+    Slot.TargetChunk = Pending;
     return Slot;
 }
 
-void Archetype::RemoveEntity(size_t ChunkIndex, uint32_t LocalIndex)
+uint32_t Archetype::CommitPendingRows()
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    const uint32_t FirstNewRow = TotalEntityCount;
+    uint32_t PendingCount = GetPendingCount();
+    if (PendingCount == 0)
+        return FirstNewRow;
+
+    // Top up the partial tail chunk with the last pending rows, keeps the pending rows dense
+    const uint32_t TailUsed = TotalEntityCount % EntitiesPerChunk;
+    const uint32_t TailFree = TailUsed == 0 ? 0 : EntitiesPerChunk - TailUsed;
+    const uint32_t MoveCount = std::min(TailFree, PendingCount);
+    if (MoveCount > 0)
+    {
+        const uint32_t DstRow = PushEntities(MoveCount);
+        for (uint32_t i = 0; i < MoveCount; ++i)
+        {
+            EntitySlot Src = GetPendingSlot(PendingCount - MoveCount + i);
+            EntitySlot Dst = GetSlot(DstRow + i);
+            CopyRow(Src.TargetChunk, Src.LocalIndex, Dst.TargetChunk, Dst.LocalIndex);
+        }
+        PendingCount -= MoveCount;
+    }
+
+    // Tail is full (or there are no pending rows left), splice the pending chunks in whole
+    const uint32_t SpliceChunks = (PendingCount + EntitiesPerChunk - 1) / EntitiesPerChunk;
+    for (uint32_t i = 0; i < SpliceChunks; ++i)
+    {
+        Chunk* Spliced = PendingChunks[i].exchange(nullptr, std::memory_order_acq_rel);
+        STRIGID_ALLOC_N(Spliced, sizeof(Chunk), DebugName);
+        MarkChanged(Spliced);
+        Chunks.push_back(Spliced);
+    }
+    TotalEntityCount += PendingCount;
+    bClassRunsDirty |= bMergedClasses;
+
+    ReleasePendingChunks();
+    return FirstNewRow;
+}
+
+uint32_t Archetype::SpliceChunks(const std::vector<Chunk*>& Staged, uint32_t RowCount, uint32_t& OutMoveCount)
 {
-    // This will be implemented with active mask in future
-    // For now, just placeholder
-    // TODO: Mark entity as inactive in chunk's ActiveMask
-    // Actual swap-and-pop happens during compaction phase
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
 
-    (void)ChunkIndex;
-    (void)LocalIndex;
+    // Same top-up as CommitPendingRows, keeps the staged rows dense
+    const uint32_t TailUsed = TotalEntityCount % EntitiesPerChunk;
+    const uint32_t TailFree = TailUsed == 0 ? 0 : EntitiesPerChunk - TailUsed;
+    OutMoveCount = std::min(TailFree, RowCount);
+    if (OutMoveCount > 0)
+    {
+        const uint32_t DstRow = PushEntities(OutMoveCount);
+        for (uint32_t i = 0; i < OutMoveCount; ++i)
+        {
+            const uint32_t SrcRow = RowCount - OutMoveCount + i;
+            EntitySlot Dst = GetSlot(DstRow + i);
+            CopyRow(Staged[SrcRow / EntitiesPerChunk], SrcRow % EntitiesPerChunk, Dst.TargetChunk, Dst.LocalIndex);
+        }
+    }
+
+    const uint32_t Remaining = RowCount - OutMoveCount;
+    const uint32_t SpliceCount = (Remaining + EntitiesPerChunk - 1) / EntitiesPerChunk;
+    const uint32_t FirstChunk = static_cast<uint32_t>(Chunks.size());
+    for (uint32_t i = 0; i < Staged.size(); ++i)
+    {
+        if (i < SpliceCount)
+        {
+            STRIGID_ALLOC_N(Staged[i], sizeof(Chunk), DebugName);
+            MarkChanged(Staged[i]);
+            Chunks.push_back(Staged[i]);
+        }
+        else
+        {
+            ChunkAllocator::Get().Free(Staged[i]);
+        }
+    }
+    TotalEntityCount += Remaining;
+    bClassRunsDirty |= bMergedClasses;
+
+    return FirstChunk;
+}
+
+void Archetype::ReleasePendingChunks()
+{
+    if (EntitiesPerChunk == 0)
+        return;
+
+    // Only chunks covering reserved rows can have been installed
+    const uint32_t UsedChunks = (GetPendingCount() + EntitiesPerChunk - 1) / EntitiesPerChunk;
+    for (uint32_t i = 0; i < UsedChunks; ++i)
+    {
+        if (Chunk* Pending = PendingChunks[i].exchange(nullptr, std::memory_order_acq_rel))
+        {
+            ChunkAllocator::Get().Free(Pending);
+        }
+    }
+    PendingRowCursor.store(0, std::memory_order_release);
+}
+
+uint32_t Archetype::CompactRows(const uint8_t* DoomedMasks)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    assert(!bTransient && HeadRow == 0);
+
+    // Rows before the first doomed one stay put
+    const uint32_t BatchesPerChunk = (EntitiesPerChunk + 7) / 8;
+    uint32_t FirstMoved = TotalEntityCount;
+    for (uint32_t Batch = 0; Batch < Chunks.size() * BatchesPerChunk; ++Batch)
+    {
+        if (DoomedMasks[Batch])
+        {
+            FirstMoved = (Batch / BatchesPerChunk) * EntitiesPerChunk + (Batch % BatchesPerChunk) * 8 +
+                std::countr_zero(static_cast<uint32_t>(DoomedMasks[Batch]));
+            break;
+        }
+    }
+    if (FirstMoved >= TotalEntityCount)
+        return TotalEntityCount;
+
+    const uint32_t Survivors = PackColumn(Chunks, Chunk::HEADER_SIZE, sizeof(EntityID), EntitiesPerChunk,
+                                          TotalEntityCount, DoomedMasks, 0);
+    for (const FieldArrayTemplate& Field : FieldArrayTemplateCache)
+    {
+        PackColumn(Chunks, Field.offsetInChunk, Field.elementSize, EntitiesPerChunk, TotalEntityCount, DoomedMasks,
+                   BlockStride);
+    }
+
+    TotalEntityCount = Survivors;
+    bClassRunsDirty |= bMergedClasses;
+
+    const size_t KeptChunks = (Survivors + EntitiesPerChunk - 1) / EntitiesPerChunk;
+    while (Chunks.size() > KeptChunks)
+    {
+        Chunk* EmptyChunk = Chunks.back();
+        Chunks.pop_back();
+        STRIGID_FREE_N(EmptyChunk, DebugName);
+        ChunkAllocator::Get().Free(EmptyChunk);
+    }
+    for (size_t ChunkIdx = FirstMoved / EntitiesPerChunk; ChunkIdx < Chunks.size(); ++ChunkIdx)
+    {
+        MarkChanged(Chunks[ChunkIdx]);
+    }
+
+    return FirstMoved;
+}
+
+void Archetype::CopyRow(Chunk* SrcChunk, uint32_t SrcIndex, Chunk* DstChunk, uint32_t DstIndex)
+{
+    MarkChanged(DstChunk);
+    GetEntityIDs(DstChunk)[DstIndex] = GetEntityIDs(SrcChunk)[SrcIndex];
+
+    for (size_t i = 0; i < FieldArrayTemplateCache.size(); ++i)
+    {
+        std::memcpy(GetElement(DstChunk, i, DstIndex), GetElement(SrcChunk, i, SrcIndex),
+                    FieldArrayTemplateCache[i].elementSize);
+    }
+}
+
+void Archetype::SwapRows(uint32_t RowA, uint32_t RowB)
+{
+    EntitySlot A = GetSlot(RowA);
+    EntitySlot B = GetSlot(RowB);
+    MarkChanged(A.TargetChunk);
+    MarkChanged(B.TargetChunk);
+    std::swap(GetEntityIDs(A.TargetChunk)[A.LocalIndex], GetEntityIDs(B.TargetChunk)[B.LocalIndex]);
+
+    for (size_t i = 0; i < FieldArrayTemplateCache.size(); ++i)
+    {
+        uint8_t* ElementA = GetElement(A.TargetChunk, i, A.LocalIndex);
+        uint8_t* ElementB = GetElement(B.TargetChunk, i, B.LocalIndex);
+        std::swap_ranges(ElementA, ElementA + FieldArrayTemplateCache[i].elementSize, ElementB);
+    }
+}
+
+void Archetype::SortClassRuns(std::vector<uint32_t>& OutMovedRows)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    bClassRunsDirty = false;
+    ClassRuns.clear();
+    if (TotalEntityCount == 0)
+        return;
+
+    // Count rows per class, merged archetypes only hold a handful of classes
+    auto FindRun = [this](ClassID ID)
+    {
+        return std::lower_bound(ClassRuns.begin(), ClassRuns.end(), ID, [](const ClassRun& Run, ClassID Value)
+        {
+            return Run.ID < Value;
+        });
+    };
+
+    for (size_t ChunkIdx = 0; ChunkIdx < Chunks.size(); ++ChunkIdx)
+    {
+        const EntityID* Ids = GetEntityIDs(Chunks[ChunkIdx]);
+        const uint32_t Count = GetChunkCount(ChunkIdx);
+        for (uint32_t i = 0; i < Count; ++i)
+        {
+            const ClassID ID = Ids[i].GetTypeID();
+            auto It = FindRun(ID);
+            if (It == ClassRuns.end() || It->ID != ID)
+            {
+                It = ClassRuns.insert(It, {ID, 0, 0});
+            }
+            ++It->Count;
+        }
+    }
+
+    uint32_t NextFirst = 0;
+    for (ClassRun& Run : ClassRuns)
+    {
+        Run.FirstRow = NextFirst;
+        NextFirst += Run.Count;
+    }
+
+    // In-place bucket permutation: walk each run, swapping strangers to the next free row of their own run
+    std::vector<uint32_t> Fill(ClassRuns.size());
+    for (size_t RunIdx = 0; RunIdx < ClassRuns.size(); ++RunIdx)
+    {
+        Fill[RunIdx] = ClassRuns[RunIdx].FirstRow;
+    }
+
+    auto ClassOfRow = [this](uint32_t Row)
+    {
+        EntitySlot Slot = GetSlot(Row);
+        return GetEntityIDs(Slot.TargetChunk)[Slot.LocalIndex].GetTypeID();
+    };
+
+    for (size_t RunIdx = 0; RunIdx < ClassRuns.size(); ++RunIdx)
+    {
+        const uint32_t RunEnd = ClassRuns[RunIdx].FirstRow + ClassRuns[RunIdx].Count;
+        while (Fill[RunIdx] < RunEnd)
+        {
+            const uint32_t Row = Fill[RunIdx];
+            const size_t Home = FindRun(ClassOfRow(Row)) - ClassRuns.begin();
+            if (Home == RunIdx)
+            {
+                ++Fill[RunIdx];
+                continue;
+            }
+
+            // Skip rows already home, the row we land on belongs elsewhere and is re-examined next
+            uint32_t& Dst = Fill[Home];
+            while (ClassOfRow(Dst) == ClassRuns[Home].ID)
+            {
+                ++Dst;
+            }
+            SwapRows(Row, Dst);
+            OutMovedRows.push_back(Row);
+            OutMovedRows.push_back(Dst);
+            ++Dst;
+        }
+    }
+}
+
+void Archetype::CopyRowBetween(Archetype& Src, Chunk* SrcChunk, uint32_t SrcIndex,
+                               Archetype& Dst, Chunk* DstChunk, uint32_t DstIndex)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    Dst.MarkChanged(DstChunk);
+    Dst.GetEntityIDs(DstChunk)[DstIndex] = Src.GetEntityIDs(SrcChunk)[SrcIndex];
+
+    for (size_t i = 0; i < Dst.CachedFieldArrayLayout.size(); ++i)
+    {
+        const FieldArrayDescriptor& Desc = Dst.CachedFieldArrayLayout[i];
+        const FieldArrayTemplate& Field = Dst.FieldArrayTemplateCache[i];
+        uint8_t* DstField = Dst.GetElement(DstChunk, i, DstIndex);
+
+        void* SrcArray = Desc.isDecomposed
+                             ? Src.GetFieldArray(SrcChunk, Desc.componentID, Desc.fieldIndex)
+                             : Src.GetComponentArrayRaw(SrcChunk, Desc.componentID);
+        if (SrcArray)
+        {
+            std::memcpy(DstField,
+                        static_cast<uint8_t*>(SrcArray) + Src.GetElementIndex(SrcIndex, Field.elementSize) * Field.elementSize,
+                        Field.elementSize);
+        }
+        else if (Dst.HasTemplateRow() && Field.elementSize <= sizeof(FieldFillPattern))
+        {
+            std::memcpy(DstField, Dst.TemplateRow[i].Bytes, Field.elementSize);
+        }
+        else
+        {
+            std::memset(DstField, 0, Field.elementSize);
+        }
+    }
 }
 
 std::vector<void*> Archetype::GetFieldArrays(Chunk* TargetChunk, ComponentTypeID TypeID)
@@ -251,7 +1048,18 @@ std::vector<void*> Archetype::GetFieldArrays(Chunk* TargetChunk, ComponentTypeID
 Chunk* Archetype::AllocateChunk()
 {
     STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
-    auto NewChunk = new Chunk();
+    if (!RingSpares.empty())
+    {
+        Chunk* Spare = RingSpares.back();
+        RingSpares.pop_back();
+        return Spare;
+    }
+
+    // Node is picked per chunk so a single archetype can be spread across nodes (Interleave)
+    // or kept together on one node keyed by its class (Partition)
+    ChunkAllocator& Allocator = ChunkAllocator::Get();
+    Chunk* NewChunk = Allocator.Allocate(Allocator.SelectNode(ArchClassID, static_cast<uint32_t>(Chunks.size())));
+    NewChunk->GetHeader().SharedSet = SharedSet;
 
     // Tracy memory profiling: Track chunk allocation with pool name
     // This lets you see separate pools for Archetypes
@@ -259,18 +1067,15 @@ Chunk* Archetype::AllocateChunk()
 
     // Debug: Track virtual memory fragmentation
     // This helps answer: "Why is 'spanned' so much larger than 'used'?"
-    static void* lastChunk = nullptr;
-    static void* firstChunk = nullptr;
-    static uint32_t chunkCount = 0;
-
-    if (firstChunk == nullptr)
+    // Tracked per archetype so registries stepping on different threads don't share state
+    if (DebugFirstChunk == nullptr)
     {
-        firstChunk = NewChunk;
+        DebugFirstChunk = NewChunk;
     }
 
-    if (lastChunk != nullptr)
+    if (DebugLastChunk != nullptr)
     {
-        ptrdiff_t gap = (char*)NewChunk - static_cast<char*>(lastChunk);
+        ptrdiff_t gap = (char*)NewChunk - static_cast<char*>(DebugLastChunk);
         STRIGID_PLOT("Chunk Gap (KB)", gap / 1024.0);
 
         // Log suspicious gaps (> 100KB means something's between chunks)
@@ -278,20 +1083,20 @@ Chunk* Archetype::AllocateChunk()
         {
             char buffer[256];
             snprintf(buffer, sizeof(buffer), "Large gap detected: %lld KB between chunk %u and %u",
-                     gap / 1024, chunkCount - 1, chunkCount);
+                     static_cast<long long>(gap / 1024), DebugChunkCount - 1, DebugChunkCount);
             STRIGID_ZONE_TEXT(buffer, strlen(buffer));
         }
     }
 
-    chunkCount++;
+    DebugChunkCount++;
 
     // Track total span
-    ptrdiff_t totalSpan = (char*)NewChunk - static_cast<char*>(firstChunk);
+    ptrdiff_t totalSpan = (char*)NewChunk - static_cast<char*>(DebugFirstChunk);
     STRIGID_PLOT("Total Span (MB)", totalSpan / (1024.0 * 1024.0));
-    STRIGID_PLOT("Chunk Count", static_cast<int64_t>(chunkCount));
-    STRIGID_PLOT("Efficiency %", (chunkCount * sizeof(Chunk) * 100.0) / (totalSpan > 0 ? totalSpan : 1));
+    STRIGID_PLOT("Chunk Count", static_cast<int64_t>(DebugChunkCount));
+    STRIGID_PLOT("Efficiency %", (DebugChunkCount * sizeof(Chunk) * 100.0) / (totalSpan > 0 ? totalSpan : 1));
 
-    lastChunk = NewChunk;
+    DebugLastChunk = NewChunk;
 
     return NewChunk;
 }
@@ -0,0 +1,68 @@
+#include "Behavior.h"
+
+#include <new>
+
+#include "Chunk.h"
+#include "ChunkAllocator.h"
+#include "Profiler.h"
+#include "Registry.h"
+
+void* BehaviorFramePool::Allocate(size_t Size)
+{
+    if (Size > MAX_FRAME_SIZE)
+        return ::operator new(Size);
+
+    const size_t Class = (Size + GRANULARITY - 1) / GRANULARITY - 1;
+    std::lock_guard<std::mutex> Lock(Mutex);
+    ++LiveFrames;
+    if (FreeFrame* Reused = FreeLists[Class])
+    {
+        FreeLists[Class] = Reused->Next;
+        return Reused;
+    }
+
+    const size_t Bytes = (Class + 1) * GRANULARITY;
+    if (Chunks.empty() || CarveOffset + Bytes > Chunk::DATA_SIZE)
+    {
+        ChunkAllocator& Allocator = ChunkAllocator::Get();
+        Chunks.push_back(Allocator.Allocate(Allocator.GetCurrentNode()));
+        CarveOffset = Chunk::HEADER_SIZE;
+        STRIGID_ALLOC_N(Chunks.back(), sizeof(Chunk), "Behavior Frames");
+    }
+
+    void* Frame = Chunks.back()->Data + CarveOffset;
+    CarveOffset += Bytes;
+    return Frame;
+}
+
+void BehaviorFramePool::Free(void* Frame, size_t Size)
+{
+    if (Size > MAX_FRAME_SIZE)
+    {
+        ::operator delete(Frame);
+        return;
+    }
+
+    const size_t Class = (Size + GRANULARITY - 1) / GRANULARITY - 1;
+    std::lock_guard<std::mutex> Lock(Mutex);
+    FreeLists[Class] = new (Frame) FreeFrame{FreeLists[Class]};
+    --LiveFrames;
+}
+
+uint32_t BehaviorFramePool::GetLiveFrameCount() const
+{
+    std::lock_guard<std::mutex> Lock(Mutex);
+    return LiveFrames;
+}
+
+void WaitTicks::await_suspend(Behavior::Handle Coroutine) const
+{
+    const Behavior::promise_type& Promise = Coroutine.promise();
+    Promise.Reg->WakeBehavior(Promise.Slot, Ticks);
+}
+
+void WaitEvent::await_suspend(Behavior::Handle Coroutine) const
+{
+    const Behavior::promise_type& Promise = Coroutine.promise();
+    Promise.Reg->ParkBehavior(Promise.Slot, EventID);
+}
@@ -0,0 +1,248 @@
+#include "ChunkAllocator.h"
+
+#include <new>
+
+#include "EngineConfig.h"
+#include "Logger.h"
+#include "Profiler.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#endif
+
+namespace
+{
+#ifndef _WIN32
+    // MPOL_BIND from <numaif.h>, spelled out so we don't need libnuma
+    constexpr int kMpolBind = 2;
+    constexpr size_t kMaxNodeMaskBits = 64;
+
+    // Parse a sysfs cpulist ("0-7,16-23") into a cpu set
+    bool ParseCpuList(const std::string& List, cpu_set_t& OutSet)
+    {
+        CPU_ZERO(&OutSet);
+        size_t Pos = 0;
+        bool bAny = false;
+        while (Pos < List.size())
+        {
+            size_t End = List.find(',', Pos);
+            if (End == std::string::npos) End = List.size();
+            const std::string Range = List.substr(Pos, End - Pos);
+            const size_t Dash = Range.find('-');
+            try
+            {
+                const int First = std::stoi(Range.substr(0, Dash));
+                const int Last = (Dash == std::string::npos) ? First : std::stoi(Range.substr(Dash + 1));
+                for (int Cpu = First; Cpu <= Last && Cpu < CPU_SETSIZE; ++Cpu)
+                {
+                    CPU_SET(Cpu, &OutSet);
+                    bAny = true;
+                }
+            }
+            catch (...)
+            {
+                // Trailing newline / empty entry
+            }
+            Pos = End + 1;
+        }
+        return bAny;
+    }
+#endif
+
+    uint32_t DetectNodeCount()
+    {
+#ifdef _WIN32
+        ULONG HighestNode = 0;
+        if (!GetNumaHighestNodeNumber(&HighestNode))
+            return 1;
+        return static_cast<uint32_t>(HighestNode) + 1;
+#else
+        uint32_t Count = 0;
+        std::error_code Error;
+        while (std::filesystem::exists("/sys/devices/system/node/node" + std::to_string(Count), Error))
+        {
+            ++Count;
+        }
+        return Count > 0 ? Count : 1;
+#endif
+    }
+}
+
+ChunkAllocator::ChunkAllocator()
+    : NodeCount(DetectNodeCount())
+      , Policy(NumaChunkPolicy::FirstTouch)
+{
+    Pools = std::make_unique<NodePool[]>(NodeCount);
+}
+
+ChunkAllocator::~ChunkAllocator()
+{
+    Shutdown();
+}
+
+void ChunkAllocator::Initialize(const EngineConfig* Config)
+{
+    Policy = Config ? Config->ChunkPlacement : NumaChunkPolicy::FirstTouch;
+
+    static const char* PolicyNames[] = {"FirstTouch", "Interleave", "Partition"};
+    LOG_INFO_F("[ChunkAllocator] %u NUMA node(s), chunk placement: %s",
+               NodeCount, PolicyNames[static_cast<uint8_t>(Policy)]);
+}
+
+void ChunkAllocator::Shutdown()
+{
+    for (uint32_t Node = 0; Node < NodeCount; ++Node)
+    {
+        std::lock_guard<std::mutex> Lock(Pools[Node].Mutex);
+        for (Chunk* Pooled : Pools[Node].FreeChunks)
+        {
+            FreePages(Pooled);
+        }
+        Pools[Node].FreeChunks.clear();
+    }
+}
+
+uint32_t ChunkAllocator::SelectNode(uint32_t PlacementSeed, uint32_t ChunkIndex) const
+{
+    if (NodeCount <= 1)
+        return 0;
+
+    switch (Policy)
+    {
+    case NumaChunkPolicy::Interleave: return ChunkIndex % NodeCount;
+    case NumaChunkPolicy::Partition: return PlacementSeed % NodeCount;
+    default: return GetCurrentNode();
+    }
+}
+
+Chunk* ChunkAllocator::Allocate(uint32_t Node)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    if (Node >= NodeCount) Node = 0;
+
+    Chunk* NewChunk = nullptr;
+    {
+        std::lock_guard<std::mutex> Lock(Pools[Node].Mutex);
+        if (!Pools[Node].FreeChunks.empty())
+        {
+            NewChunk = Pools[Node].FreeChunks.back();
+            Pools[Node].FreeChunks.pop_back();
+        }
+    }
+
+    if (!NewChunk)
+    {
+        // FirstTouch leaves placement to the OS, everything else binds explicitly
+        const bool bBind = NodeCount > 1 && Policy != NumaChunkPolicy::FirstTouch;
+        NewChunk = AllocatePages(Node, bBind);
+        if (!NewChunk)
+            throw std::bad_alloc();
+    }
+
+    ChunkHeader& Header = NewChunk->GetHeader();
+    Header = ChunkHeader{};
+    Header.NumaNode = Node;
+    return NewChunk;
+}
+
+void ChunkAllocator::Free(Chunk* TargetChunk)
+{
+    if (!TargetChunk)
+        return;
+
+    uint32_t Node = TargetChunk->GetHeader().NumaNode;
+    if (Node >= NodeCount) Node = 0;
+
+    std::lock_guard<std::mutex> Lock(Pools[Node].Mutex);
+    Pools[Node].FreeChunks.push_back(TargetChunk);
+}
+
+uint32_t ChunkAllocator::GetCurrentNode() const
+{
+    if (NodeCount <= 1)
+        return 0;
+
+#ifdef _WIN32
+    PROCESSOR_NUMBER Processor;
+    GetCurrentProcessorNumberEx(&Processor);
+    USHORT Node = 0;
+    if (!GetNumaProcessorNodeEx(&Processor, &Node))
+        return 0;
+    return Node < NodeCount ? Node : 0;
+#else
+    unsigned Cpu = 0;
+    unsigned Node = 0;
+    if (syscall(SYS_getcpu, &Cpu, &Node, nullptr) != 0)
+        return 0;
+    return Node < NodeCount ? Node : 0;
+#endif
+}
+
+bool ChunkAllocator::PinCurrentThreadToNode(uint32_t Node) const
+{
+    if (NodeCount <= 1 || Node >= NodeCount)
+        return false;
+
+#ifdef _WIN32
+    GROUP_AFFINITY Affinity = {};
+    if (!GetNumaNodeProcessorMaskEx(static_cast<USHORT>(Node), &Affinity))
+        return false;
+    return SetThreadGroupAffinity(GetCurrentThread(), &Affinity, nullptr) != 0;
+#else
+    std::ifstream CpuListFile("/sys/devices/system/node/node" + std::to_string(Node) + "/cpulist");
+    std::string CpuList;
+    if (!std::getline(CpuListFile, CpuList))
+        return false;
+
+    cpu_set_t CpuSet;
+    if (!ParseCpuList(CpuList, CpuSet))
+        return false;
+    return sched_setaffinity(0, sizeof(CpuSet), &CpuSet) == 0;
+#endif
+}
+
+Chunk* ChunkAllocator::AllocatePages(uint32_t Node, bool bBindToNode)
+{
+#ifdef _WIN32
+    void* Memory = bBindToNode
+                       ? VirtualAllocExNuma(GetCurrentProcess(), nullptr, sizeof(Chunk), MEM_RESERVE | MEM_COMMIT,
+                                            PAGE_READWRITE, Node)
+                       : VirtualAlloc(nullptr, sizeof(Chunk), MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    return static_cast<Chunk*>(Memory);
+#else
+    void* Memory = mmap(nullptr, sizeof(Chunk), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (Memory == MAP_FAILED)
+        return nullptr;
+
+    if (bBindToNode && Node < kMaxNodeMaskBits)
+    {
+        // Bind before first touch so the pages fault in on the requested node
+        unsigned long NodeMask = 1ul << Node;
+        syscall(SYS_mbind, Memory, sizeof(Chunk), kMpolBind, &NodeMask, kMaxNodeMaskBits, 0);
+    }
+    return static_cast<Chunk*>(Memory);
+#endif
+}
+
+void ChunkAllocator::FreePages(Chunk* TargetChunk)
+{
+#ifdef _WIN32
+    VirtualFree(TargetChunk, 0, MEM_RELEASE);
+#else
+    munmap(TargetChunk, sizeof(Chunk));
+#endif
+}
@@ -0,0 +1,255 @@
+#include "ChunkPager.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "Logger.h"
+#include "Profiler.h"
+
+ChunkPager::~ChunkPager()
+{
+    if (Writer.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> Lock(Mutex);
+            bStopWriter = true;
+        }
+        QueueCondition.notify_one();
+        Writer.join();
+    }
+
+    if (File.is_open())
+    {
+        File.close();
+        std::remove(Path.c_str());
+    }
+}
+
+bool ChunkPager::Open(const std::string& InPath)
+{
+    Path = InPath;
+    File.open(Path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!File.is_open())
+    {
+        LOG_ERROR_F("ChunkPager: can't open page file '%s', dormant chunks stay resident", Path.c_str());
+        return false;
+    }
+
+    Writer = std::thread(&ChunkPager::WriterMain, this);
+    return true;
+}
+
+uint32_t ChunkPager::Write(const std::vector<uint8_t>& Page)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    std::vector<uint8_t> Compressed;
+    Compress(Page, Compressed);
+
+    uint32_t Handle;
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        if (!FreeHandles.empty())
+        {
+            Handle = FreeHandles.back();
+            FreeHandles.pop_back();
+        }
+        else
+        {
+            Handle = static_cast<uint32_t>(Slots.size());
+            Slots.emplace_back();
+        }
+
+        PageSlot& Slot = Slots[Handle];
+        Slot.Size = static_cast<uint32_t>(Compressed.size());
+        Slot.RawSize = static_cast<uint32_t>(Page.size());
+        Slot.Queued = std::move(Compressed);
+        Slot.bLive = true;
+        ReserveRange(Slot, Slot.Size);
+
+        WriteQueue.push_back(Handle);
+        ++LiveCount;
+        LiveBytes += Slot.Size;
+    }
+    QueueCondition.notify_one();
+    return Handle;
+}
+
+bool ChunkPager::Read(uint32_t Handle, std::vector<uint8_t>& Out)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    std::vector<uint8_t> Compressed;
+    uint32_t RawSize;
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        if (Handle >= Slots.size() || !Slots[Handle].bLive)
+            return false;
+
+        PageSlot& Slot = Slots[Handle];
+        auto Queued = std::find(WriteQueue.begin(), WriteQueue.end(), Handle);
+        if (Queued != WriteQueue.end())
+        {
+            // Never reached the writer, no disk round trip
+            WriteQueue.erase(Queued);
+            Compressed = std::move(Slot.Queued);
+        }
+        else
+        {
+            // Blocks until the writer is done if this page is the one being written
+            std::lock_guard<std::mutex> FileLock(FileMutex);
+            Compressed.resize(Slot.Size);
+            File.seekg(static_cast<std::streamoff>(Slot.Offset));
+            File.read(reinterpret_cast<char*>(Compressed.data()), Slot.Size);
+            if (!File)
+            {
+                File.clear();
+                Compressed.clear();
+                LOG_ERROR_F("ChunkPager: failed to read page %u from '%s'", Handle, Path.c_str());
+            }
+        }
+
+        // Release the handle and its file range
+        FreeRanges.push_back({Slot.Offset, Slot.Capacity});
+        FreeHandles.push_back(Handle);
+        --LiveCount;
+        LiveBytes -= Slot.Size;
+        RawSize = Slot.RawSize;
+        Slot = PageSlot{};
+    }
+
+    return Decompress(Compressed.data(), Compressed.size(), Out, RawSize);
+}
+
+void ChunkPager::Reset()
+{
+    std::lock_guard<std::mutex> Lock(Mutex);
+    WriteQueue.clear();
+    Slots.clear();
+    FreeHandles.clear();
+    FreeRanges.clear();
+    FileEnd = 0;
+    LiveCount = 0;
+    LiveBytes = 0;
+}
+
+uint32_t ChunkPager::GetPageCount() const
+{
+    std::lock_guard<std::mutex> Lock(Mutex);
+    return LiveCount;
+}
+
+uint64_t ChunkPager::GetCompressedBytes() const
+{
+    std::lock_guard<std::mutex> Lock(Mutex);
+    return LiveBytes;
+}
+
+void ChunkPager::ReserveRange(PageSlot& Slot, uint32_t Size)
+{
+    auto Fit = std::find_if(FreeRanges.begin(), FreeRanges.end(), [Size](const std::pair<uint64_t, uint32_t>& Range)
+    {
+        return Range.second >= Size;
+    });
+
+    if (Fit != FreeRanges.end())
+    {
+        Slot.Offset = Fit->first;
+        Slot.Capacity = Fit->second;
+        *Fit = FreeRanges.back();
+        FreeRanges.pop_back();
+        return;
+    }
+
+    Slot.Offset = FileEnd;
+    Slot.Capacity = Size;
+    FileEnd += Size;
+}
+
+void ChunkPager::WriterMain()
+{
+    std::vector<uint8_t> Bytes;
+    for (;;)
+    {
+        std::unique_lock<std::mutex> Lock(Mutex);
+        QueueCondition.wait(Lock, [this] { return bStopWriter || !WriteQueue.empty(); });
+        if (bStopWriter)
+            return;
+
+        PageSlot& Slot = Slots[WriteQueue.front()];
+        WriteQueue.pop_front();
+        Bytes = std::move(Slot.Queued);
+        Slot.Queued.clear();
+        const uint64_t Offset = Slot.Offset;
+
+        // Take the file before letting go of the queue, so a reader of this page waits for the write
+        std::lock_guard<std::mutex> FileLock(FileMutex);
+        Lock.unlock();
+
+        File.seekp(static_cast<std::streamoff>(Offset));
+        File.write(reinterpret_cast<const char*>(Bytes.data()), static_cast<std::streamsize>(Bytes.size()));
+        File.flush();
+        if (!File)
+        {
+            File.clear();
+            LOG_ERROR_F("ChunkPager: failed to write page to '%s'", Path.c_str());
+        }
+    }
+}
+
+void ChunkPager::Compress(const std::vector<uint8_t>& Raw, std::vector<uint8_t>& Out)
+{
+    Out.clear();
+    Out.reserve(Raw.size() / 2);
+
+    const size_t Size = Raw.size();
+    size_t i = 0;
+    while (i < Size)
+    {
+        size_t Zeros = 0;
+        while (i + Zeros < Size && Raw[i + Zeros] == 0 && Zeros < UINT16_MAX)
+        {
+            ++Zeros;
+        }
+        i += Zeros;
+
+        // Literals run until the next zero run worth a token (4+ bytes)
+        size_t Literals = 0;
+        while (i + Literals < Size && Literals < UINT16_MAX)
+        {
+            const size_t j = i + Literals;
+            if (j + 4 <= Size && Raw[j] == 0 && Raw[j + 1] == 0 && Raw[j + 2] == 0 && Raw[j + 3] == 0)
+                break;
+            ++Literals;
+        }
+
+        const uint16_t Token[2] = {static_cast<uint16_t>(Zeros), static_cast<uint16_t>(Literals)};
+        const uint8_t* TokenBytes = reinterpret_cast<const uint8_t*>(Token);
+        Out.insert(Out.end(), TokenBytes, TokenBytes + sizeof(Token));
+        Out.insert(Out.end(), Raw.begin() + i, Raw.begin() + i + Literals);
+        i += Literals;
+    }
+}
+
+bool ChunkPager::Decompress(const uint8_t* Data, size_t Size, std::vector<uint8_t>& Out, size_t RawSize)
+{
+    Out.assign(RawSize, 0);
+
+    size_t Pos = 0;
+    size_t Cursor = 0;
+    while (Cursor + 2 * sizeof(uint16_t) <= Size)
+    {
+        uint16_t Token[2];
+        std::memcpy(Token, Data + Cursor, sizeof(Token));
+        Cursor += sizeof(Token);
+
+        Pos += Token[0];
+        if (Pos + Token[1] > RawSize || Cursor + Token[1] > Size)
+            return false;
+
+        std::memcpy(Out.data() + Pos, Data + Cursor, Token[1]);
+        Pos += Token[1];
+        Cursor += Token[1];
+    }
+
+    return Pos == RawSize && Cursor == Size;
+}
@@ -1,28 +1,184 @@
 #include "Registry.h"
+#include "ChunkAllocator.h"
+#include "EngineConfig.h"
 #include "Profiler.h"
+#include "StreamingLoader.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <immintrin.h>
+#include <string>
 
 #include "SchemaReflector.h"
 
+namespace
+{
+    // One resolved row of a batched field copy, Slot is the position in the caller's ID list
+    struct BatchRow
+    {
+        Chunk* TargetChunk;
+        Archetype* Arch;
+        uint32_t LocalIndex;
+        uint32_t Slot;
+    };
+
+    // Per-thread scratch so batched access works from jobs without allocating every call
+    thread_local std::vector<EntityRecord*> tBatchRecords;
+    thread_local std::vector<uint32_t> tBatchIdGenerations;
+    thread_local std::vector<uint32_t> tBatchRecordGenerations;
+    thread_local std::vector<BatchRow> tBatchRows;
+
+    constexpr uint32_t BATCH_PREFETCH_DISTANCE = 8;
+
+    // xxHash32-style rounds over 4 AVX2 accumulators of 8 32-bit lanes, 128 input bytes per step so the
+    // multiply latency of one accumulator overlaps the others. Input is a byte stream, the result doesn't
+    // depend on how it was split into Update calls
+    class LaneHasher
+    {
+    public:
+        static constexpr uint32_t PRIME1 = 2654435761u;
+        static constexpr uint32_t PRIME2 = 2246822519u;
+        static constexpr uint64_t PRIME64 = 0x9E3779B97F4A7C15ull;
+        static constexpr uint32_t STRIPE = 4 * sizeof(__m256i);
+
+        LaneHasher()
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                Acc[i] = _mm256_mullo_epi32(_mm256_add_epi32(_mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 8),
+                                                             _mm256_set1_epi32(8 * i)),
+                                            _mm256_set1_epi32(PRIME1));
+            }
+        }
+
+        void Update(const uint8_t* Data, size_t Size)
+        {
+            Length += Size;
+            if (PendingBytes > 0)
+            {
+                const size_t Fill = std::min<size_t>(Size, STRIPE - PendingBytes);
+                std::memcpy(Pending + PendingBytes, Data, Fill);
+                PendingBytes += static_cast<uint32_t>(Fill);
+                Data += Fill;
+                Size -= Fill;
+                if (PendingBytes < STRIPE)
+                    return;
+                Stripe(Pending);
+                PendingBytes = 0;
+            }
+            for (; Size >= STRIPE; Data += STRIPE, Size -= STRIPE)
+            {
+                Stripe(Data);
+            }
+            std::memcpy(Pending, Data, Size);
+            PendingBytes = static_cast<uint32_t>(Size);
+        }
+
+        uint64_t Finish()
+        {
+            if (PendingBytes > 0)
+            {
+                std::memset(Pending + PendingBytes, 0, STRIPE - PendingBytes);
+                Stripe(Pending);
+            }
+            alignas(32) uint32_t Lanes[32];
+            for (int i = 0; i < 4; ++i)
+            {
+                _mm256_store_si256(reinterpret_cast<__m256i*>(Lanes) + i, Acc[i]);
+            }
+            uint64_t Hash = Length * PRIME64;
+            for (uint32_t Lane : Lanes)
+            {
+                Hash = (Hash ^ Lane) * PRIME64;
+                Hash ^= Hash >> 29;
+            }
+            return Hash;
+        }
+
+    private:
+        void Stripe(const uint8_t* Data)
+        {
+            const __m256i Prime1 = _mm256_set1_epi32(PRIME1);
+            const __m256i Prime2 = _mm256_set1_epi32(PRIME2);
+            for (int i = 0; i < 4; ++i)
+            {
+                const __m256i Input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Data) + i);
+                __m256i Lane = _mm256_add_epi32(Acc[i], _mm256_mullo_epi32(Input, Prime2));
+                Lane = _mm256_or_si256(_mm256_slli_epi32(Lane, 13), _mm256_srli_epi32(Lane, 19));
+                Acc[i] = _mm256_mullo_epi32(Lane, Prime1);
+            }
+        }
+
+        __m256i Acc[4];
+        alignas(32) uint8_t Pending[STRIPE];
+        uint32_t PendingBytes = 0;
+        uint64_t Length = 0;
+    };
+
+    // Group value index hits by chunk, rows ascending
+    void SortIndexHits(std::vector<IndexHit>::iterator Begin, std::vector<IndexHit>::iterator End)
+    {
+        std::sort(Begin, End, [](const IndexHit& A, const IndexHit& B)
+        {
+            return A.TargetChunk != B.TargetChunk ? A.TargetChunk < B.TargetChunk : A.LocalIndex < B.LocalIndex;
+        });
+    }
+}
+
 Registry::Registry()
-    : NextEntityIndex(1) // Start at 1 (0 is reserved for Invalid)
 {
     STRIGID_ZONE_N("Registry::Constructor");
-    // Reserve space for entity index
-    EntityIndex.reserve(1024);
+    // Sized once up front, CreateConcurrent reads it without locking
+    ClassArchetypeCache.resize(MAX_ENTITY_CLASSES, nullptr);
+
+    CommandBuffers = std::make_unique<EntityCommandBuffer[]>(JobSystem::MAX_THREAD_SLOTS);
+    for (uint32_t Slot = 0; Slot < JobSystem::MAX_THREAD_SLOTS; ++Slot)
+    {
+        CommandBuffers[Slot].SetSources(&CommandPhase, &PendingIds);
+    }
+
     InitializeArchetypes();
+
+    BehaviorCallbackID = RegisterTimerCallback(&Registry::ResumeBehaviors);
 }
 
 Registry::Registry(const EngineConfig* Config)
     : Registry()
 {
     HistorySlab.Initialize(Config);
-    Registry();
+
+    if (Config->bMergeSameSignatureClasses)
+    {
+        MergeClassArchetypes();
+    }
+
+    if (Config->DormantChunkPageOutSeconds > 0)
+    {
+        // One page file per registry, worlds page independently
+        static std::atomic<uint32_t> PageFileCounter{0};
+        const std::string PageFile = std::string(Config->PageFilePath) + "." +
+            std::to_string(PageFileCounter.fetch_add(1)) + ".bin";
+        if (Pager.Open(PageFile))
+        {
+            PageOutSeconds = static_cast<uint32_t>(Config->DormantChunkPageOutSeconds);
+        }
+    }
 }
 
 Registry::~Registry()
 {
     STRIGID_ZONE_N("Registry::Destructor");
+    ReleaseStagedRuns();
+    for (uint32_t Slot = 0; Slot < BehaviorSlots.size(); ++Slot)
+    {
+        if (BehaviorSlots[Slot].Coroutine)
+            DestroyBehavior(Slot);
+    }
+
     // Clean up all archetypes
     for (auto& Pair : Archetypes)
     {
@@ -31,10 +187,18 @@ Registry::~Registry()
     Archetypes.clear();
 }
 
-Archetype* Registry::GetOrCreateArchetype(const Signature& Sig, const ClassID& ID)
+Archetype* Registry::GetOrCreateArchetype(const Signature& Sig, const ClassID& ID, uint32_t SharedSet, bool bDormant)
 {
     STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
-    auto key = Archetype::ArchetypeKey(Sig, ID);
+    // A class's own storage may be a merged archetype keyed by another class
+    if (SharedSet == 0 && !bDormant && ID < ClassArchetypeCache.size())
+    {
+        Archetype* ClassArch = ClassArchetypeCache[ID];
+        if (ClassArch && ClassArch->ArchSignature == Sig)
+            return ClassArch;
+    }
+
+    auto key = Archetype::ArchetypeKey(Sig, ID, SharedSet, bDormant);
 
     // Check if archetype already exists
     auto It = Archetypes.find(key);
@@ -43,18 +207,39 @@ Archetype* Registry::GetOrCreateArchetype(const Signature& Sig, const ClassID& I
         return It->second;
     }
 
-    // Create new archetype
-    auto NewArchetype = new Archetype(Sig, ID);
-
-    // TODO: In Week 5, we'll build component layout from signature
-    // For now, create empty archetype
-    std::vector<ComponentMetaEx> Components;
-    NewArchetype->BuildLayout(Components);
+    // Create new archetype, layout built from the signature
+    Archetype* NewArchetype = CreateArchetype(key);
 
     Archetypes[key] = NewArchetype;
     return NewArchetype;
 }
 
+Archetype* Registry::CreateArchetype(const Archetype::ArchetypeKey& Key)
+{
+    MetaRegistry& MR = MetaRegistry::Get();
+    const EntityMeta& Meta = MR.EntityGetters[Key.ID];
+
+    // Rings append and expire whole runs of rows, they stay SoA
+    auto NewArchetype = new Archetype(Key);
+    NewArchetype->bBlocked = Meta.bBlockedLayout && Meta.TransientLifetime == 0;
+    NewArchetype->BuildLayout(BuildComponentList(Key.Sig, Key.ID));
+    NewArchetype->ChangeVersionSource = &ChangeVersion;
+
+    // Template row from the class defaults (zeroed without), also used for components added to the class later
+    auto Defaults = MR.ClassToDefaults.find(Key.ID);
+    NewArchetype->BuildTemplateRow(Defaults != MR.ClassToDefaults.end() ? Defaults->second
+                                                                          : std::vector<FieldDefault>{});
+
+    // Transient classes never change archetype, their class archetype is the ring
+    if (const uint32_t Lifetime = Meta.TransientLifetime; Lifetime > 0 && !Key.Dormant)
+    {
+        NewArchetype->bTransient = true;
+        NewArchetype->TransientLifetime = Lifetime;
+        TransientArchetypes.push_back(NewArchetype);
+    }
+    return NewArchetype;
+}
+
 EntityID Registry::AllocateEntityID(uint16_t TypeID)
 {
     STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
@@ -69,7 +254,7 @@ EntityID Registry::AllocateEntityID(uint16_t TypeID)
         FreeIndices.pop();
 
         // Increment generation for recycled index
-        uint16_t Generation = EntityIndex[Index].Generation + 1;
+        EntityGeneration Generation = (EntityIndex[Index].Generation + 1) & EntityIDLayout::GENERATION_MASK;
         if (Generation == 0) // Wrapped around
             Generation = 1; // Skip 0 (reserved for invalid)
 
@@ -81,7 +266,14 @@ EntityID Registry::AllocateEntityID(uint16_t TypeID)
     else
     {
         // Allocate new index
-        Id.Index = NextEntityIndex++;
+        uint32_t Index = EntityIndex.ReserveRange(1);
+        if (Index == 0)
+        {
+            LOG_ERROR("Entity index space exhausted");
+            return Id;
+        }
+
+        Id.Index = Index;
         Id.Generation = 1; // First generation
         Id.TypeID = TypeID;
         Id.OwnerID = 0;
@@ -95,115 +287,1990 @@ void Registry::FreeEntityID(EntityID Id)
     STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
 
     uint32_t Index = Id.GetIndex();
-    if (Index >= EntityIndex.size())
+    EntityRecord* Record = EntityIndex.Find(Index);
+    if (!Record)
         return;
 
     // Add to free list
     FreeIndices.push(Index);
 
+    if (LiveBehaviors > 0)
+    {
+        ReapBehaviors(Id);
+    }
+
     // Invalidate record
-    EntityIndex[Index].Arch = nullptr;
-    EntityIndex[Index].TargetChunk = nullptr;
+    Record->Arch = nullptr;
+    Record->TargetChunk = nullptr;
 }
 
 void Registry::Destroy(EntityID Id)
+{
+    // Defer destruction until the next sync point
+    GetCommandBuffer().Destroy(Id);
+}
+
+EntityRecord* Registry::FindRecord(EntityID Id, bool bPageIn)
+{
+    if (!Id.IsValid())
+        return nullptr;
+
+    EntityRecord* Record = EntityIndex.Find(Id.GetIndex());
+
+    // Validate generation
+    if (!Record || Record->Generation != Id.GetGeneration() || !Record->Arch)
+        return nullptr;
+
+    if (!bPageIn)
+        return Record;
+
+    if (Record->IsPagedOut())
+    {
+        PageIn(Record->Arch, Record->ChunkIndex);
+    }
+    else if (Record->Arch->bDormant && PageOutSeconds > 0)
+    {
+        // A dormant chunk in use shouldn't be paged out, any recent time will do so the race is harmless
+        std::atomic_ref<uint32_t>(Record->TargetChunk->GetHeader().LastTouched).store(
+            PagingClock, std::memory_order_relaxed);
+    }
+
+    return Record;
+}
+
+uint32_t Registry::CopyFieldsBatch(ComponentTypeID TypeID, std::span<const EntityID> Ids,
+                                   std::span<const FieldColumn> Columns, uint8_t* OutValid, bool bScatter)
 {
     STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
-    // Defer destruction until end of frame
-    PendingDestructions.push_back(Id);
+    const uint32_t Count = static_cast<uint32_t>(Ids.size());
+    const uint32_t FieldCount = static_cast<uint32_t>(ComponentFieldRegistry::Get().GetFieldCount(TypeID));
+    constexpr size_t MAX_BATCH_COLUMNS = 64;
+    if (Columns.size() > MAX_BATCH_COLUMNS)
+    {
+        LOG_ERROR_F("Batched field access: %zu columns requested, max is %zu", Columns.size(), MAX_BATCH_COLUMNS);
+        return 0;
+    }
+    for (const FieldColumn& Column : Columns)
+    {
+        if (Column.FieldIndex >= FieldCount)
+        {
+            LOG_ERROR_F("Batched field access: component %u has no field %u", TypeID, Column.FieldIndex);
+            return 0;
+        }
+    }
+
+    // Pass 1: fetch records, a missing record gets a generation no ID can have
+    // Padded to the SIMD width so the compare loop needs no tail
+    const uint32_t PaddedCount = (Count + 7) & ~7u;
+    tBatchRecords.resize(PaddedCount);
+    tBatchIdGenerations.resize(PaddedCount);
+    tBatchRecordGenerations.resize(PaddedCount);
+    for (uint32_t i = 0; i < PaddedCount; ++i)
+    {
+        EntityRecord* Record = i < Count ? EntityIndex.Find(Ids[i].GetIndex()) : nullptr;
+        if (Record && Record->IsPagedOut() && Record->Generation == Ids[i].GetGeneration())
+        {
+            PageIn(Record->Arch, Record->ChunkIndex);
+        }
+        Record = (Record && Record->IsValid()) ? Record : nullptr;
+        tBatchRecords[i] = Record;
+        tBatchIdGenerations[i] = i < Count ? Ids[i].GetGeneration() : 0;
+        tBatchRecordGenerations[i] = Record ? Record->Generation : UINT32_MAX;
+    }
+
+    // Pass 2: validate generations 8 at a time, then drop entities that don't have the component
+    tBatchRows.clear();
+    for (uint32_t Base = 0; Base < PaddedCount; Base += 8)
+    {
+        const __m256i IdGen = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&tBatchIdGenerations[Base]));
+        const __m256i RecGen = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&tBatchRecordGenerations[Base]));
+        uint32_t Live = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(IdGen, RecGen))));
+
+        for (uint32_t Lane = 0; Lane < 8 && Base + Lane < Count; ++Lane)
+        {
+            const uint32_t i = Base + Lane;
+            const EntityRecord* Record = tBatchRecords[i];
+            const bool bValid = ((Live >> Lane) & 1) && Record->Arch->ArchSignature.Has(TypeID - 1);
+            if (OutValid)
+            {
+                OutValid[i] = bValid;
+            }
+            if (bValid)
+            {
+                tBatchRows.push_back({Record->TargetChunk, Record->Arch, Record->Index, i});
+            }
+        }
+    }
+
+    // Group by chunk (and row inside it) so each chunk's field arrays are walked front to back
+    std::sort(tBatchRows.begin(), tBatchRows.end(), [](const BatchRow& A, const BatchRow& B)
+    {
+        return A.TargetChunk != B.TargetChunk ? A.TargetChunk < B.TargetChunk : A.LocalIndex < B.LocalIndex;
+    });
+
+    const size_t ColumnCount = Columns.size();
+    size_t Offsets[MAX_BATCH_COLUMNS];
+    size_t Sizes[MAX_BATCH_COLUMNS];
+    Archetype* LayoutArch = nullptr;
+
+    const uint32_t RowCount = static_cast<uint32_t>(tBatchRows.size());
+    for (uint32_t r = 0; r < RowCount; ++r)
+    {
+        const BatchRow& Row = tBatchRows[r];
+        if (bScatter && (r == 0 || Row.TargetChunk != tBatchRows[r - 1].TargetChunk))
+        {
+            Row.Arch->MarkChanged(Row.TargetChunk);
+        }
+
+        // Field offsets only change with the archetype
+        if (Row.Arch != LayoutArch)
+        {
+            LayoutArch = Row.Arch;
+            const int32_t TableIndex = LayoutArch->GetFieldTableIndex(TypeID);
+            for (size_t c = 0; c < ColumnCount; ++c)
+            {
+                const Archetype::FieldArrayTemplate& Field =
+                    LayoutArch->FieldArrayTemplateCache[TableIndex + Columns[c].FieldIndex];
+                Offsets[c] = Field.offsetInChunk;
+                Sizes[c] = Field.elementSize;
+            }
+        }
+
+        // Pull a later row's first field in while this one is copied
+        if (r + BATCH_PREFETCH_DISTANCE < RowCount && ColumnCount > 0)
+        {
+            const BatchRow& Ahead = tBatchRows[r + BATCH_PREFETCH_DISTANCE];
+            _mm_prefetch(reinterpret_cast<const char*>(Ahead.TargetChunk->Data + Offsets[0] +
+                                                       LayoutArch->GetElementIndex(Ahead.LocalIndex, Sizes[0]) * Sizes[0]),
+                         _MM_HINT_T0);
+        }
+
+        for (size_t c = 0; c < ColumnCount; ++c)
+        {
+            uint8_t* Element = Row.TargetChunk->Data + Offsets[c] +
+                LayoutArch->GetElementIndex(Row.LocalIndex, Sizes[c]) * Sizes[c];
+            uint8_t* Caller = static_cast<uint8_t*>(Columns[c].Data) + static_cast<size_t>(Row.Slot) * Sizes[c];
+            if (bScatter)
+            {
+                std::memcpy(Element, Caller, Sizes[c]);
+            }
+            else
+            {
+                std::memcpy(Caller, Element, Sizes[c]);
+            }
+        }
+    }
+
+    return RowCount;
 }
 
-void Registry::ProcessDeferredDestructions()
+void Registry::FlushCommandBuffers()
 {
     STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
 
-    for (EntityID Id : PendingDestructions)
+    // No concurrent appends while the dense storage is reshuffled
+    std::unique_lock<std::shared_mutex> AppendLock(ConcurrentAppendMutex);
+    CommitConcurrentCreates();
+    SpliceStagedRuns();
+    PageOutIdleChunks();
+
+    // Merge
+    PlaybackScratch.clear();
+    for (uint32_t Slot = 0; Slot < JobSystem::MAX_THREAD_SLOTS; ++Slot)
     {
-        if (!Id.IsValid())
+        EntityCommandBuffer& Buffer = CommandBuffers[Slot];
+        if (Buffer.IsEmpty())
             continue;
 
-        uint32_t Index = Id.GetIndex();
-        if (Index >= EntityIndex.size())
-            continue;
+        PlaybackScratch.insert(PlaybackScratch.end(), Buffer.GetCommands().begin(), Buffer.GetCommands().end());
+        Buffer.Reset();
+    }
 
-        EntityRecord& Record = EntityIndex[Index];
+    STRIGID_PLOT("Structural Commands", static_cast<int64_t>(PlaybackScratch.size()));
+    if (PlaybackScratch.empty())
+        return;
 
-        // Validate generation
-        if (Record.Generation != Id.GetGeneration())
-            continue;
+    // Deterministic order regardless of which worker recorded what
+    std::sort(PlaybackScratch.begin(), PlaybackScratch.end());
+    PendingIds.BeginPlayback();
 
-        if (!Record.IsValid())
-            continue;
+    // Play back runs of the same command type in bulk
+    EntityCommand* Cursor = PlaybackScratch.data();
+    EntityCommand* End = Cursor + PlaybackScratch.size();
+    while (Cursor != End)
+    {
+        EntityCommand* RunEnd = Cursor;
+        while (RunEnd != End && RunEnd->Type == Cursor->Type)
+        {
+            ++RunEnd;
+        }
 
-        // TODO: Week 12 - Mark entity as inactive in chunk's ActiveMask
-        // For now, just invalidate the record
+        // Targets created earlier in this playback swap their pending ID for the real one
+        if (Cursor->Type != EntityCommandType::Create)
+        {
+            for (EntityCommand* Command = Cursor; Command != RunEnd; ++Command)
+            {
+                Command->Target = PendingIds.Resolve(Command->Target);
+            }
+        }
 
-        // Remove from archetype (will be implemented with swap-and-pop in Week 12)
-        // Record.Arch->RemoveEntity(chunkIndex, Record.Index);
+        switch (Cursor->Type)
+        {
+        case EntityCommandType::Create:
+            PlaybackCreates(Cursor, RunEnd);
+            break;
+        case EntityCommandType::Destroy:
+            PlaybackDestroys(Cursor, RunEnd);
+            break;
+        case EntityCommandType::AddComponent:
+        case EntityCommandType::RemoveComponent:
+            for (const EntityCommand* Command = Cursor; Command != RunEnd; ++Command)
+            {
+                MigrateEntity(Command->Target, Command->Payload, Command->Type == EntityCommandType::AddComponent);
+            }
+            break;
+        case EntityCommandType::SetShared:
+            for (const EntityCommand* Command = Cursor; Command != RunEnd; ++Command)
+            {
+                ApplySharedValue(Command->Target, Command->Payload);
+            }
+            break;
+        case EntityCommandType::Activate:
+        case EntityCommandType::Deactivate:
+            PlaybackActivations(Cursor, RunEnd, Cursor->Type == EntityCommandType::Activate);
+            break;
+        }
 
-        // Free the entity ID
-        FreeEntityID(Id);
+        Cursor = RunEnd;
     }
 
-    PendingDestructions.clear();
-
-    STRIGID_PLOT("PendingDestructions", static_cast<double>(PendingDestructions.size()));
+    PlaybackScratch.clear();
 }
 
-void Registry::InitializeArchetypes()
+void Registry::PlaybackCreates(const EntityCommand* Begin, const EntityCommand* End)
 {
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
     MetaRegistry& MR = MetaRegistry::Get();
-    ComponentFieldRegistry& CFR = ComponentFieldRegistry::Get();
-    // need to combine classes in the meta registry that have the same TypeID.
 
-    for (auto& Arch : MR.ClassToArchetype)
+    // Count per class so every archetype grows once
+    std::unordered_map<ClassID, std::pair<Archetype*, uint32_t>> Batches;
+    for (const EntityCommand* Command = Begin; Command != End; ++Command)
     {
-        auto key = Archetype::ArchetypeKey(Arch.second, Arch.first);
-        Archetype*& NewArch = Archetypes[key];
-        if (!NewArch)
+        const ClassID ID = static_cast<ClassID>(Command->Payload);
+        auto& [Arch, Count] = Batches[ID];
+        if (!Arch && ID < ClassArchetypeCache.size())
+        {
+            Arch = ClassArchetypeCache[ID];
+        }
+        if (!Arch)
         {
-            NewArch = new Archetype(key);
-            std::vector<ComponentMetaEx> Components;
-            for (auto& CompID : MR.ClassToComponentList[Arch.first])
+            auto It = MR.ClassToArchetype.find(ID);
+            if (It == MR.ClassToArchetype.end())
             {
-                Components.push_back(CFR.GetComponentMeta(CompID));
+                LOG_ERROR_F("Deferred create of unregistered class %u ignored", ID);
+                continue;
             }
-            NewArch->BuildLayout(Components);
+            Arch = GetOrCreateArchetype(It->second, ID);
         }
+        ++Count;
     }
-}
 
-void Registry::ResetRegistry()
-{
-    for (auto& Entity : EntityIndex)
+    // Rows created for one class, handed to its OnCreate hook in one go
+    struct CreatedRange
+    {
+        ClassID ID;
+        Archetype* Arch;
+        uint32_t FirstRow;
+        uint32_t Count;
+    };
+
+    // Reserve rows, Count becomes the next global row for that class
+    std::vector<CreatedRange> HookRanges;
+    for (auto& [ID, Batch] : Batches)
+    {
+        if (Batch.first)
+        {
+            const uint32_t Count = Batch.second;
+            Batch.second = Batch.first->PushEntities(Count);
+            Batch.first->StampTemplateRows(Batch.second, Count);
+            if (MR.EntityGetters[ID].OnCreate)
+            {
+                HookRanges.push_back({ID, Batch.first, Batch.second, Count});
+            }
+        }
+    }
+
+    // IDs are handed out in command order, so they don't depend on which worker recorded the create
+    for (const EntityCommand* Command = Begin; Command != End; ++Command)
     {
-        Entity.Arch = nullptr;
+        const ClassID ID = static_cast<ClassID>(Command->Payload);
+        auto& [Arch, NextRow] = Batches[ID];
+        if (!Arch)
+            continue;
+
+        // Recorded creates carry a pending ID, transient spawns may go without one
+        Archetype::EntitySlot Slot = Arch->GetSlot(NextRow++);
+        if (Arch->bTransient && !Command->Target.IsValid())
+        {
+            Arch->GetEntityIDs(Slot.TargetChunk)[Slot.LocalIndex] = EntityID::Invalid();
+            continue;
+        }
+
+        EntityID Id = AllocateEntityID(ID);
+        PendingIds.Assign(Command->Target, Id);
+        Arch->GetEntityIDs(Slot.TargetChunk)[Slot.LocalIndex] = Id;
+        WriteRecord(Id, Arch, Slot);
+        Arch->IssuedIdCount += Arch->bTransient;
     }
-    EntityIndex.clear();
-    while (!FreeIndices.empty())
+
+    // Hooks run once every row is live, in class order so the result doesn't depend on map iteration
+    std::sort(HookRanges.begin(), HookRanges.end(), [](const CreatedRange& A, const CreatedRange& B)
     {
-        FreeIndices.pop();
+        return A.ID < B.ID;
+    });
+    for (const CreatedRange& Range : HookRanges)
+    {
+        InvokeRowHook(Range.Arch, MR.EntityGetters[Range.ID].OnCreate, Range.FirstRow, Range.Count);
     }
-    PendingDestructions.clear();
-    NextEntityIndex = 1;
 }
 
-uint32_t Registry::GetTotalChunkCount() const
+void Registry::CommitConcurrentCreates()
 {
-    uint32_t totalChunks = 0;
-    for (const auto& [sig, archetype] : Archetypes)
+    for (auto& [key, arch] : Archetypes)
     {
-        totalChunks += static_cast<uint32_t>(archetype->Chunks.size());
+        if (arch->GetPendingCount() == 0)
+            continue;
+
+        // Committed rows may have moved chunk or row, rewrite their records from the ID column
+        const uint32_t FirstNewRow = arch->CommitPendingRows();
+        for (uint32_t Row = FirstNewRow; Row < arch->TotalEntityCount; ++Row)
+        {
+            Archetype::EntitySlot Slot = arch->GetSlot(Row);
+            WriteRecord(arch->GetEntityIDs(Slot.TargetChunk)[Slot.LocalIndex], arch, Slot);
+        }
     }
-    return totalChunks;
 }
 
-uint32_t Registry::GetTotalEntityCount() const
+void Registry::PlaybackDestroys(const EntityCommand* Begin, const EntityCommand* End)
 {
-    uint32_t totalEntities = 0;
-    for (const auto& [sig, archetype] : Archetypes)
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    MetaRegistry& MR = MetaRegistry::Get();
+
+    struct DoomedRow
     {
-        totalEntities += archetype->TotalEntityCount;
+        Archetype* Arch;
+        uint32_t Row;
+        EntityID Id;
+    };
+
+    std::vector<DoomedRow> Doomed;
+    Doomed.reserve(End - Begin);
+    for (const EntityCommand* Command = Begin; Command != End; ++Command)
+    {
+        if (EntityRecord* Record = FindRecord(Command->Target))
+        {
+            Archetype* Arch = Record->Arch;
+            Doomed.push_back({
+                Arch, Arch->bTransient
+                          ? Arch->GetTransientRow(Record->TargetChunk, Record->Index)
+                          : Record->ChunkIndex * Arch->EntitiesPerChunk + Record->Index,
+                Command->Target
+            });
+        }
     }
-    return totalEntities;
+
+    // Group by archetype, highest row first: the tail that swap-and-pop moves down is never doomed,
+    // so every remaining row index stays valid. Duplicates end up adjacent.
+    std::sort(Doomed.begin(), Doomed.end(), [](const DoomedRow& A, const DoomedRow& B)
+    {
+        return A.Arch != B.Arch ? A.Arch < B.Arch : A.Row > B.Row;
+    });
+
+    // OnDestroy runs before anything moves, over runs of adjacent doomed rows of one class
+    struct DoomedRange
+    {
+        Archetype* Arch;
+        UpdateFunc Hook;
+        uint32_t FirstRow;
+        uint32_t Count;
+    };
+
+    std::vector<DoomedRange> HookRanges;
+    for (size_t i = 0; i < Doomed.size(); ++i)
+    {
+        if (i > 0 && Doomed[i].Arch == Doomed[i - 1].Arch && Doomed[i].Row == Doomed[i - 1].Row)
+            continue;
+
+        UpdateFunc Hook = MR.EntityGetters[Doomed[i].Id.GetTypeID()].OnDestroy;
+        if (!Hook)
+            continue;
+
+        // Rows descend, so a run grows downwards
+        if (!HookRanges.empty() && HookRanges.back().Arch == Doomed[i].Arch && HookRanges.back().Hook == Hook &&
+            HookRanges.back().FirstRow == Doomed[i].Row + 1)
+        {
+            --HookRanges.back().FirstRow;
+            ++HookRanges.back().Count;
+        }
+        else
+        {
+            HookRanges.push_back({Doomed[i].Arch, Hook, Doomed[i].Row, 1});
+        }
+    }
+
+    for (const DoomedRange& Range : HookRanges)
+    {
+        InvokeRowHook(Range.Arch, Range.Hook, Range.FirstRow, Range.Count);
+    }
+
+    // Transient rows are collected per ring (as sequence numbers, the head moves while they're filled)
+    std::vector<uint64_t> TransientSequences;
+    for (size_t i = 0; i < Doomed.size(); ++i)
+    {
+        if (i > 0 && Doomed[i].Arch == Doomed[i - 1].Arch && Doomed[i].Row == Doomed[i - 1].Row)
+            continue;
+
+        Archetype* Arch = Doomed[i].Arch;
+        if (Arch->bTransient)
+        {
+            TransientSequences.push_back(Arch->ExpiredRows + Doomed[i].Row);
+            --Arch->IssuedIdCount;
+        }
+        else
+        {
+            RemoveRow(EntityIndex[Doomed[i].Id.GetIndex()]);
+        }
+
+        for (std::unique_ptr<SparseSet>& Set : SparseSets)
+        {
+            if (Set)
+                Set->Remove(Doomed[i].Id);
+        }
+        FreeEntityID(Doomed[i].Id);
+
+        if (Arch->bTransient && (i + 1 == Doomed.size() || Doomed[i + 1].Arch != Arch))
+        {
+            std::reverse(TransientSequences.begin(), TransientSequences.end());
+            RemoveTransientRows(Arch, TransientSequences);
+            TransientSequences.clear();
+        }
+    }
+}
+
+uint32_t Registry::DestroyFlaggedRows(Archetype* Arch, const std::vector<uint8_t>& DoomedMasks)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    MetaRegistry& MR = MetaRegistry::Get();
+    const uint32_t BatchesPerChunk = (Arch->EntitiesPerChunk + 7) / 8;
+
+    // Doomed rows ascending (the head chunk of a ring is masked from HeadRow on)
+    std::vector<uint32_t> Rows;
+    for (uint32_t Batch = 0; Batch < DoomedMasks.size(); ++Batch)
+    {
+        const uint32_t ChunkIdx = Batch / BatchesPerChunk;
+        const uint32_t FirstRow = ChunkIdx * Arch->EntitiesPerChunk + Arch->GetChunkFirstRow(ChunkIdx) - Arch->HeadRow +
+            (Batch % BatchesPerChunk) * 8;
+        for (uint32_t Bits = DoomedMasks[Batch]; Bits; Bits &= Bits - 1)
+        {
+            Rows.push_back(FirstRow + std::countr_zero(Bits));
+        }
+    }
+    if (Rows.empty())
+        return 0;
+
+    // OnDestroy runs before anything moves, over runs of adjacent doomed rows of one class
+    UpdateFunc RunHook = nullptr;
+    uint32_t RunFirst = 0;
+    uint32_t RunCount = 0;
+    for (uint32_t Row : Rows)
+    {
+        Archetype::EntitySlot Slot = Arch->GetSlot(Row);
+        const EntityID Id = Arch->GetEntityIDs(Slot.TargetChunk)[Slot.LocalIndex];
+        UpdateFunc Hook = MR.EntityGetters[Id.IsValid() ? Id.GetTypeID() : Arch->ArchClassID].OnDestroy;
+        if (Hook == RunHook && RunFirst + RunCount == Row)
+        {
+            ++RunCount;
+            continue;
+        }
+        if (RunHook)
+        {
+            InvokeRowHook(Arch, RunHook, RunFirst, RunCount);
+        }
+        RunHook = Hook;
+        RunFirst = Row;
+        RunCount = 1;
+    }
+    if (RunHook)
+    {
+        InvokeRowHook(Arch, RunHook, RunFirst, RunCount);
+    }
+
+    for (uint32_t Row : Rows)
+    {
+        Archetype::EntitySlot Slot = Arch->GetSlot(Row);
+        const EntityID Id = Arch->GetEntityIDs(Slot.TargetChunk)[Slot.LocalIndex];
+        if (!Id.IsValid())
+            continue;
+
+        for (std::unique_ptr<SparseSet>& Set : SparseSets)
+        {
+            if (Set)
+                Set->Remove(Id);
+        }
+        FreeEntityID(Id);
+        Arch->IssuedIdCount -= Arch->bTransient;
+    }
+
+    // Rings never reorder, their rows leave like destroy commands do
+    if (Arch->bTransient)
+    {
+        std::vector<uint64_t> Sequences(Rows.size());
+        for (size_t i = 0; i < Rows.size(); ++i)
+        {
+            Sequences[i] = Arch->ExpiredRows + Rows[i];
+        }
+        RemoveTransientRows(Arch, Sequences);
+        return static_cast<uint32_t>(Rows.size());
+    }
+
+    const uint32_t FirstMoved = Arch->CompactRows(DoomedMasks.data());
+    for (uint32_t Row = FirstMoved; Row < Arch->TotalEntityCount; ++Row)
+    {
+        Archetype::EntitySlot Slot = Arch->GetSlot(Row);
+        WriteRecord(Arch->GetEntityIDs(Slot.TargetChunk)[Slot.LocalIndex], Arch, Slot);
+    }
+    return static_cast<uint32_t>(Rows.size());
+}
+
+void Registry::RemoveTransientRows(Archetype* Arch, std::vector<uint64_t>& Sequences)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+
+    // Doomed rows at the head just expire early, every other one takes the head row from the back
+    // (the moved row then expires with the tick of the row it replaced)
+    size_t Lo = 0;
+    size_t Hi = Sequences.size();
+    while (Lo < Hi)
+    {
+        if (Sequences[Lo] == Arch->ExpiredRows)
+        {
+            Arch->ExpireRows(1);
+            ++Lo;
+            continue;
+        }
+
+        const uint32_t Row = static_cast<uint32_t>(Sequences[--Hi] - Arch->ExpiredRows);
+        Archetype::EntitySlot Head = Arch->GetSlot(0);
+        Archetype::EntitySlot Slot = Arch->GetSlot(Row);
+        Arch->CopyRow(Head.TargetChunk, Head.LocalIndex, Slot.TargetChunk, Slot.LocalIndex);
+
+        const EntityID Moved = Arch->GetEntityIDs(Slot.TargetChunk)[Slot.LocalIndex];
+        if (Moved.IsValid())
+        {
+            WriteRecord(Moved, Arch, Slot);
+        }
+        Arch->ExpireRows(1);
+    }
+}
+
+void Registry::ExpireTransients()
+{
+    if (TransientArchetypes.empty())
+        return;
+
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    MetaRegistry& MR = MetaRegistry::Get();
+    for (Archetype* Arch : TransientArchetypes)
+    {
+        // Rows spawned since the last tick boundary expire together
+        const uint64_t EndSequence = Arch->ExpiredRows + Arch->TotalEntityCount;
+        if (EndSequence > (Arch->SpawnMarks.empty() ? Arch->ExpiredRows : Arch->SpawnMarks.back().EndSequence))
+        {
+            Arch->SpawnMarks.push_back({TransientTick, EndSequence});
+        }
+
+        // Destroyed rows may have pushed the head past a mark already
+        uint64_t ExpireEnd = Arch->ExpiredRows;
+        while (!Arch->SpawnMarks.empty() && Arch->SpawnMarks.front().Tick + Arch->TransientLifetime <= TransientTick)
+        {
+            ExpireEnd = std::max(ExpireEnd, Arch->SpawnMarks.front().EndSequence);
+            Arch->SpawnMarks.pop_front();
+        }
+
+        const uint32_t Count = static_cast<uint32_t>(ExpireEnd - Arch->ExpiredRows);
+        if (Count == 0)
+            continue;
+
+        if (UpdateFunc OnDestroy = MR.EntityGetters[Arch->ArchClassID].OnDestroy)
+        {
+            InvokeRowHook(Arch, OnDestroy, 0, Count);
+        }
+
+        // Only rows that were given an ID have a record to release
+        for (uint32_t Row = 0; Arch->IssuedIdCount > 0 && Row < Count;)
+        {
+            Archetype::EntitySlot Slot = Arch->GetSlot(Row);
+            const uint32_t Run = std::min(Count - Row, Arch->EntitiesPerChunk - Slot.LocalIndex);
+            const EntityID* Ids = Arch->GetEntityIDs(Slot.TargetChunk) + Slot.LocalIndex;
+            for (uint32_t i = 0; i < Run; ++i)
+            {
+                if (!Ids[i].IsValid())
+                    continue;
+
+                for (std::unique_ptr<SparseSet>& Set : SparseSets)
+                {
+                    if (Set)
+                        Set->Remove(Ids[i]);
+                }
+                FreeEntityID(Ids[i]);
+                --Arch->IssuedIdCount;
+            }
+            Row += Run;
+        }
+
+        Arch->ExpireRows(Count);
+        STRIGID_PLOT("Transient Rows Expired", static_cast<int64_t>(Count));
+    }
+    ++TransientTick;
+}
+
+uint32_t Registry::RegisterTimerCallback(TimerCallback Callback)
+{
+    std::lock_guard<std::mutex> Lock(TimerMutex);
+    TimerCallbacks.push_back(Callback);
+    return static_cast<uint32_t>(TimerCallbacks.size() - 1);
+}
+
+TimerHandle Registry::ScheduleTimer(EntityID Id, uint32_t DelayTicks, uint32_t CallbackID, uint64_t Payload)
+{
+    std::lock_guard<std::mutex> Lock(TimerMutex);
+    if (CallbackID >= TimerCallbacks.size())
+    {
+        LOG_WARN_F("ScheduleTimer: unknown callback %u, ignored", CallbackID);
+        return {};
+    }
+    return Timers.Insert(Id, DelayTicks, CallbackID, Payload);
+}
+
+bool Registry::CancelTimer(TimerHandle Handle)
+{
+    std::lock_guard<std::mutex> Lock(TimerMutex);
+    return Timers.Cancel(Handle);
+}
+
+void Registry::FireTimers()
+{
+    std::vector<TimerCallback> Callbacks;
+    {
+        std::lock_guard<std::mutex> Lock(TimerMutex);
+        TimerScratch.clear();
+        Timers.Advance(TimerScratch);
+        if (TimerScratch.empty())
+            return;
+        Callbacks = TimerCallbacks;
+    }
+
+    STRIGID_ZONE_C(STRIGID_COLOR_LOGIC);
+
+    struct DueTimer
+    {
+        uint32_t CallbackID;
+        Archetype* Arch;
+        uint32_t Row;
+        TimerFire Fire;
+    };
+
+    // Resolve every timer to its row, stale IDs are dropped here
+    std::vector<DueTimer> Due;
+    Due.reserve(TimerScratch.size());
+    for (const TimerExpiry& Expiry : TimerScratch)
+    {
+        EntityRecord* Record = FindRecord(Expiry.Id);
+        if (!Record)
+            continue;
+
+        Archetype* Arch = Record->Arch;
+        Due.push_back({
+            Expiry.CallbackID, Arch,
+            Arch->bTransient
+                ? Arch->GetTransientRow(Record->TargetChunk, Record->Index)
+                : Record->ChunkIndex * Arch->EntitiesPerChunk + Record->Index,
+            {Expiry.Id, Expiry.Payload, Record->TargetChunk, Record->Index}
+        });
+    }
+    STRIGID_PLOT("Timers Fired", static_cast<int64_t>(Due.size()));
+    STRIGID_PLOT("Timers Dropped", static_cast<int64_t>(TimerScratch.size() - Due.size()));
+
+    // One callback call per (callback, archetype), rows in storage order
+    std::sort(Due.begin(), Due.end(), [](const DueTimer& A, const DueTimer& B)
+    {
+        if (A.CallbackID != B.CallbackID)
+            return A.CallbackID < B.CallbackID;
+        return A.Arch != B.Arch ? A.Arch < B.Arch : A.Row < B.Row;
+    });
+
+    std::vector<TimerFire> Fires;
+    Fires.reserve(Due.size());
+    for (size_t Begin = 0; Begin < Due.size();)
+    {
+        size_t End = Begin;
+        Fires.clear();
+        while (End < Due.size() && Due[End].CallbackID == Due[Begin].CallbackID && Due[End].Arch == Due[Begin].Arch)
+        {
+            Fires.push_back(Due[End++].Fire);
+        }
+
+        Callbacks[Due[Begin].CallbackID](this, Due[Begin].Arch, Fires.data(), static_cast<uint32_t>(Fires.size()));
+        Begin = End;
+    }
+}
+
+uint32_t Registry::CreateIndex(ComponentTypeID TypeID, uint32_t FieldIndex, uint32_t ElementSize,
+                               IndexKeyLoader LoadKey, ValueIndexKind Kind)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    if (FieldIndex >= ComponentFieldRegistry::Get().GetFieldCount(TypeID))
+    {
+        LOG_WARN_F("CreateIndex: component %u has no field %u, no index created", TypeID, FieldIndex);
+        return UINT32_MAX;
+    }
+
+    FieldIndexes.push_back(std::make_unique<FieldIndexState>(
+        FieldIndexState{TypeID, FieldIndex, ElementSize, LoadKey, ValueIndex(Kind), {}}));
+    FieldIndexState& State = *FieldIndexes.back();
+
+    // Every chunk is new to the index, the first step builds it whole
+    CollectIndexSources(State);
+    for (IndexSource& Source : State.Sources)
+    {
+        Source.Shadow.resize(Source.Arch->Chunks.size());
+        for (uint32_t ChunkIndex = 0; ChunkIndex < Source.Arch->Chunks.size(); ++ChunkIndex)
+        {
+            if (Source.Arch->Chunks[ChunkIndex])
+            {
+                DiffIndexedChunk(State, Source, ChunkIndex);
+            }
+        }
+    }
+    State.Index.Apply(IndexRemoved, IndexAdded);
+    State.SyncedVersion = ChangeVersion++;
+
+    return static_cast<uint32_t>(FieldIndexes.size() - 1);
+}
+
+void Registry::UpdateIndexes()
+{
+    if (FieldIndexes.empty())
+        return;
+
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    uint32_t DiffedChunks = 0;
+    for (std::unique_ptr<FieldIndexState>& State : FieldIndexes)
+    {
+        if (State->KnownArchetypes != Archetypes.size())
+        {
+            CollectIndexSources(*State);
+        }
+
+        for (IndexSource& Source : State->Sources)
+        {
+            Archetype* Arch = Source.Arch;
+
+            // Chunks released since the last step take their rows along
+            for (size_t ChunkIndex = Arch->Chunks.size(); ChunkIndex < Source.Shadow.size(); ++ChunkIndex)
+            {
+                for (const ValueIndex::Entry& Gone : Source.Shadow[ChunkIndex])
+                {
+                    if (Gone.Id.IsValid())
+                        IndexRemoved.push_back(Gone);
+                }
+            }
+            Source.Shadow.resize(Arch->Chunks.size());
+
+            for (uint32_t ChunkIndex = 0; ChunkIndex < Arch->Chunks.size(); ++ChunkIndex)
+            {
+                // Paged-out chunks can't have changed
+                const Chunk* Target = Arch->Chunks[ChunkIndex];
+                if (!Target)
+                    continue;
+
+                if (Target->GetHeader().ChangeVersion <= State->SyncedVersion &&
+                    Source.Shadow[ChunkIndex].size() == Arch->GetChunkCount(ChunkIndex))
+                    continue;
+
+                DiffIndexedChunk(*State, Source, ChunkIndex);
+                ++DiffedChunks;
+            }
+        }
+
+        State->Index.Apply(IndexRemoved, IndexAdded);
+        State->SyncedVersion = ChangeVersion;
+    }
+
+    // Writes from here on are newer than every index
+    ++ChangeVersion;
+    STRIGID_PLOT("Index Chunks Diffed", static_cast<int64_t>(DiffedChunks));
+}
+
+void Registry::CollectIndexSources(FieldIndexState& State)
+{
+    // Dormant archetypes are indexed too, their paged-out chunks are skipped by DiffIndexedChunk
+    for (auto& [Key, Arch] : Archetypes)
+    {
+        if (Arch->bTransient)
+            continue;
+
+        const int32_t TableIndex = Arch->GetFieldTableIndex(State.TypeID);
+        if (TableIndex < 0)
+            continue;
+
+        if (std::any_of(State.Sources.begin(), State.Sources.end(),
+                        [Arch](const IndexSource& Source) { return Source.Arch == Arch; }))
+            continue;
+
+        const Archetype::FieldArrayTemplate& Field = Arch->FieldArrayTemplateCache[TableIndex + State.FieldIndex];
+        if (Field.elementSize != State.ElementSize)
+        {
+            LOG_WARN_F("CreateIndex: field %u of component %u is %zu bytes, not %u, archetype skipped",
+                       State.FieldIndex, State.TypeID, Field.elementSize, State.ElementSize);
+            continue;
+        }
+
+        State.Sources.push_back({Arch, Field.offsetInChunk, {}});
+    }
+    State.KnownArchetypes = Archetypes.size();
+}
+
+void Registry::DiffIndexedChunk(const FieldIndexState& State, IndexSource& Source, uint32_t ChunkIndex)
+{
+    Archetype* Arch = Source.Arch;
+    Chunk* Target = Arch->Chunks[ChunkIndex];
+    if (!Target)
+        return; // Paged out, its rows keep the entries they had when it went
+    const uint32_t Count = Arch->GetChunkCount(ChunkIndex);
+    const EntityID* Ids = Arch->GetEntityIDs(Target);
+    const uint8_t* Column = Target->Data + Source.ColumnOffset;
+
+    std::vector<ValueIndex::Entry>& Shadow = Source.Shadow[ChunkIndex];
+    if (Shadow.size() < Count)
+    {
+        Shadow.resize(Count, {0.0, EntityID::Invalid()});
+    }
+
+    // Rows that moved show up as a removal at the old row and an insertion at the new one
+    for (uint32_t Row = 0; Row < Shadow.size(); ++Row)
+    {
+        ValueIndex::Entry Current{0.0, EntityID::Invalid()};
+        if (Row < Count)
+        {
+            const double Key = State.LoadKey(Column, Arch->GetElementIndex(Row, State.ElementSize));
+            if (Key == Key) // NaN isn't indexed
+            {
+                Current = {Key, Ids[Row]};
+            }
+        }
+
+        ValueIndex::Entry& Previous = Shadow[Row];
+        if (Previous == Current)
+            continue;
+
+        if (Previous.Id.IsValid())
+            IndexRemoved.push_back(Previous);
+        if (Current.Id.IsValid())
+            IndexAdded.push_back(Current);
+        Previous = Current;
+    }
+    Shadow.resize(Count);
+}
+
+template <typename Fn>
+void Registry::VisitIndex(uint32_t IndexID, double Min, double Max, bool bRange, Fn&& Visit)
+{
+    if (IndexID >= FieldIndexes.size())
+        return;
+
+    const ValueIndex& Index = FieldIndexes[IndexID]->Index;
+    if (!bRange)
+    {
+        Index.VisitEqual(Min, Visit);
+    }
+    else if (Index.GetKind() == ValueIndexKind::Ordered)
+    {
+        Index.VisitRange(Min, Max, Visit);
+    }
+    else
+    {
+        LOG_WARN_F("QueryIndexRange: index %u is a hash index, use QueryIndexEqual", IndexID);
+    }
+}
+
+uint32_t Registry::QueryIndexRange(uint32_t IndexID, double Min, double Max, std::vector<EntityID>& OutIds)
+{
+    const size_t First = OutIds.size();
+    VisitIndex(IndexID, Min, Max, true, [&](EntityID Id)
+    {
+        if (FindRecord(Id, false))
+            OutIds.push_back(Id);
+    });
+    return static_cast<uint32_t>(OutIds.size() - First);
+}
+
+uint32_t Registry::QueryIndexEqual(uint32_t IndexID, double Value, std::vector<EntityID>& OutIds)
+{
+    const size_t First = OutIds.size();
+    VisitIndex(IndexID, Value, Value, false, [&](EntityID Id)
+    {
+        if (FindRecord(Id, false))
+            OutIds.push_back(Id);
+    });
+    return static_cast<uint32_t>(OutIds.size() - First);
+}
+
+uint32_t Registry::QueryIndexRange(uint32_t IndexID, double Min, double Max, std::vector<IndexHit>& OutHits)
+{
+    const size_t First = OutHits.size();
+    VisitIndex(IndexID, Min, Max, true, [&](EntityID Id)
+    {
+        if (EntityRecord* Record = FindRecord(Id))
+            OutHits.push_back({Id, Record->TargetChunk, Record->Index});
+    });
+    SortIndexHits(OutHits.begin() + First, OutHits.end());
+    return static_cast<uint32_t>(OutHits.size() - First);
+}
+
+uint32_t Registry::QueryIndexEqual(uint32_t IndexID, double Value, std::vector<IndexHit>& OutHits)
+{
+    const size_t First = OutHits.size();
+    VisitIndex(IndexID, Value, Value, false, [&](EntityID Id)
+    {
+        if (EntityRecord* Record = FindRecord(Id))
+            OutHits.push_back({Id, Record->TargetChunk, Record->Index});
+    });
+    SortIndexHits(OutHits.begin() + First, OutHits.end());
+    return static_cast<uint32_t>(OutHits.size() - First);
+}
+
+BehaviorHandle Registry::StartBehavior(EntityID Id, Behavior&& Body)
+{
+    Behavior::Handle Coroutine = Body.Release();
+    if (!FindRecord(Id, false))
+    {
+        LOG_WARN_F("StartBehavior: entity %u is stale, behavior dropped", Id.GetIndex());
+        Coroutine.destroy();
+        return {};
+    }
+
+    uint32_t Slot = FreeBehaviorSlot;
+    if (Slot != UINT32_MAX)
+    {
+        FreeBehaviorSlot = BehaviorSlots[Slot].NextFree;
+    }
+    else
+    {
+        Slot = static_cast<uint32_t>(BehaviorSlots.size());
+        BehaviorSlots.emplace_back();
+    }
+
+    BehaviorSlot& Target = BehaviorSlots[Slot];
+    Target.Coroutine = Coroutine;
+    Target.Owner = Id;
+    Target.bStopRequested = false;
+    Coroutine.promise().Reg = this;
+    Coroutine.promise().Slot = Slot;
+    BehaviorOwners.emplace(Id.GetIndex(), Slot);
+    ++LiveBehaviors;
+
+    const BehaviorHandle Handle{Slot, Target.Generation};
+    RunBehavior(Slot);
+    return Handle;
+}
+
+bool Registry::StopBehavior(BehaviorHandle Handle)
+{
+    if (Handle.Slot >= BehaviorSlots.size())
+        return false;
+
+    BehaviorSlot& Target = BehaviorSlots[Handle.Slot];
+    if (Target.Generation != Handle.Generation || !Target.Coroutine || Target.bStopRequested)
+        return false;
+
+    if (Target.bRunning)
+    {
+        Target.bStopRequested = true;
+    }
+    else
+    {
+        DestroyBehavior(Handle.Slot);
+    }
+    return true;
+}
+
+void Registry::SignalEvent(uint32_t EventID)
+{
+    auto Found = EventWaiters.find(EventID);
+    if (Found == EventWaiters.end())
+        return;
+
+    // Woken behaviors may wait on the same event again, they go to a fresh list
+    SignalScratch.swap(Found->second);
+    for (uint64_t Payload : SignalScratch)
+    {
+        const uint32_t Slot = static_cast<uint32_t>(Payload);
+        if (BehaviorSlots[Slot].Generation == static_cast<uint32_t>(Payload >> 32))
+        {
+            ScheduleTimer(BehaviorSlots[Slot].Owner, 1, BehaviorCallbackID, Payload);
+        }
+    }
+    SignalScratch.clear();
+}
+
+void Registry::WakeBehavior(uint32_t Slot, uint32_t Ticks)
+{
+    const BehaviorSlot& Target = BehaviorSlots[Slot];
+    ScheduleTimer(Target.Owner, Ticks, BehaviorCallbackID, Slot | static_cast<uint64_t>(Target.Generation) << 32);
+}
+
+void Registry::ParkBehavior(uint32_t Slot, uint32_t EventID)
+{
+    EventWaiters[EventID].push_back(Slot | static_cast<uint64_t>(BehaviorSlots[Slot].Generation) << 32);
+}
+
+void Registry::ResumeBehaviors(Registry* Reg, [[maybe_unused]] Archetype* Arch, const TimerFire* Fires, uint32_t Count)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_LOGIC);
+    for (uint32_t i = 0; i < Count; ++i)
+    {
+        // Stopped behaviors leave their wake-up behind, the slot generation tells
+        const uint32_t Slot = static_cast<uint32_t>(Fires[i].Payload);
+        if (Reg->BehaviorSlots[Slot].Generation == static_cast<uint32_t>(Fires[i].Payload >> 32) &&
+            Reg->BehaviorSlots[Slot].Coroutine)
+        {
+            Reg->RunBehavior(Slot);
+        }
+    }
+    STRIGID_PLOT("Behaviors Resumed", static_cast<int64_t>(Count));
+}
+
+void Registry::RunBehavior(uint32_t Slot)
+{
+    // A resumed behavior may start others, which can grow BehaviorSlots
+    BehaviorSlots[Slot].bRunning = true;
+    BehaviorSlots[Slot].Coroutine.resume();
+    BehaviorSlots[Slot].bRunning = false;
+
+    if (BehaviorSlots[Slot].Coroutine.done() || BehaviorSlots[Slot].bStopRequested)
+    {
+        DestroyBehavior(Slot);
+    }
+}
+
+void Registry::DestroyBehavior(uint32_t Slot)
+{
+    BehaviorSlot& Target = BehaviorSlots[Slot];
+    auto [First, Last] = BehaviorOwners.equal_range(Target.Owner.GetIndex());
+    for (auto It = First; It != Last; ++It)
+    {
+        if (It->second == Slot)
+        {
+            BehaviorOwners.erase(It);
+            break;
+        }
+    }
+
+    // The slot is recycled before the frame goes, destructors of its locals may call back in
+    const Behavior::Handle Coroutine = Target.Coroutine;
+    Target.Coroutine = nullptr;
+    Target.bStopRequested = false;
+    Target.Generation = Target.Generation + 1 == 0 ? 1 : Target.Generation + 1;
+    Target.NextFree = FreeBehaviorSlot;
+    FreeBehaviorSlot = Slot;
+    --LiveBehaviors;
+    Coroutine.destroy();
+}
+
+void Registry::ReapBehaviors(EntityID Id)
+{
+    auto [First, Last] = BehaviorOwners.equal_range(Id.GetIndex());
+    if (First == Last)
+        return;
+
+    std::vector<uint32_t> Owned;
+    for (auto It = First; It != Last; ++It)
+    {
+        Owned.push_back(It->second);
+    }
+
+    for (uint32_t Slot : Owned)
+    {
+        if (BehaviorSlots[Slot].bRunning)
+        {
+            BehaviorSlots[Slot].bStopRequested = true;
+        }
+        else
+        {
+            DestroyBehavior(Slot);
+        }
+    }
+}
+
+void Registry::PlaybackActivations(const EntityCommand* Begin, const EntityCommand* End, bool bActivate)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    MetaRegistry& MR = MetaRegistry::Get();
+
+    // Move class by class (stable, so command order decides row order) to keep each class's rows contiguous
+    std::vector<const EntityCommand*> Commands;
+    Commands.reserve(End - Begin);
+    for (const EntityCommand* Command = Begin; Command != End; ++Command)
+    {
+        Commands.push_back(Command);
+    }
+    std::stable_sort(Commands.begin(), Commands.end(), [](const EntityCommand* A, const EntityCommand* B)
+    {
+        return A->Target.GetTypeID() < B->Target.GetTypeID();
+    });
+
+    // Rows appended to one archetype by consecutive moves, handed to the class hook in one go
+    struct HookRange
+    {
+        Archetype* Arch;
+        ClassID ID;
+        uint32_t FirstRow;
+        uint32_t Count;
+    };
+
+    std::vector<HookRange> Ranges;
+    for (const EntityCommand* Command : Commands)
+    {
+        EntityRecord* Record = FindRecord(Command->Target, false);
+        if (!Record || Record->Arch->bDormant != bActivate)
+            continue; // Stale, or already in the requested state
+
+        if (Record->Arch->bTransient)
+        {
+            LOG_WARN_F("Deactivate: class %u is transient, ignored", Command->Target.GetTypeID());
+            continue;
+        }
+
+        if (Record->IsPagedOut())
+        {
+            PageIn(Record->Arch, Record->ChunkIndex);
+            if (!Record->IsValid())
+                continue;
+        }
+
+        Archetype* Dst = GetTwin(Record->Arch);
+        MoveToArchetype(Command->Target, *Record, Dst);
+
+        const ClassID ID = Command->Target.GetTypeID();
+        const EntityMeta& Meta = MR.EntityGetters[ID];
+        if (!(bActivate ? Meta.OnActivate : Meta.OnDeactivate))
+            continue;
+
+        const uint32_t Row = Dst->TotalEntityCount - 1;
+        if (!Ranges.empty() && Ranges.back().Arch == Dst && Ranges.back().ID == ID &&
+            Ranges.back().FirstRow + Ranges.back().Count == Row)
+        {
+            ++Ranges.back().Count;
+        }
+        else
+        {
+            Ranges.push_back({Dst, ID, Row, 1});
+        }
+    }
+
+    // Destinations only grew during the moves, so every range is still in place
+    for (const HookRange& Range : Ranges)
+    {
+        UpdateFunc Hook = bActivate ? MR.EntityGetters[Range.ID].OnActivate : MR.EntityGetters[Range.ID].OnDeactivate;
+        InvokeRowHook(Range.Arch, Hook, Range.FirstRow, Range.Count);
+    }
+}
+
+void Registry::InvokeRowHook(Archetype* Arch, UpdateFunc Hook, uint32_t FirstRow, uint32_t Count)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    constexpr size_t MAX_FIELD_ARRAYS = 64; // Max total fields across all components in archetype
+    void* fieldArrayTable[MAX_FIELD_ARRAYS];
+
+    for (uint32_t Row = FirstRow, EndRow = FirstRow + Count; Row < EndRow;)
+    {
+        Archetype::EntitySlot Slot = Arch->GetSlot(Row);
+        const uint32_t SliceCount = Arch->GetKernelSliceCount(Slot.LocalIndex,
+                                                              std::min(EndRow - Row, Arch->EntitiesPerChunk - Slot.LocalIndex));
+        Arch->MarkChanged(Slot.TargetChunk);
+        Arch->BuildFieldArrayTable(Slot.TargetChunk, fieldArrayTable, Slot.LocalIndex);
+        Hook(this, 0.0, fieldArrayTable, Arch->GetKernelCount(SliceCount));
+        Row += SliceCount;
+    }
+}
+
+Archetype* Registry::GetTwin(Archetype* Arch)
+{
+    if (!Arch->Twin)
+    {
+        Arch->Twin = GetOrCreateArchetype(Arch->ArchSignature, Arch->ArchClassID, Arch->SharedSet, !Arch->bDormant);
+    }
+    return Arch->Twin;
+}
+
+bool Registry::IsActive(EntityID Id)
+{
+    EntityRecord* Record = FindRecord(Id, false);
+    return Record && !Record->Arch->bDormant;
+}
+
+bool Registry::SaveRegion(std::span<const EntityID> Ids, const std::string& Path)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+
+    // Live IDs grouped by class, every class is one batch in its own archetype's layout
+    std::vector<EntityID> Live;
+    Live.reserve(Ids.size());
+    for (EntityID Id : Ids)
+    {
+        if (FindRecord(Id) && ClassArchetypeCache[Id.GetTypeID()] && !ClassArchetypeCache[Id.GetTypeID()]->bTransient)
+        {
+            Live.push_back(Id);
+        }
+    }
+    std::stable_sort(Live.begin(), Live.end(), [](EntityID A, EntityID B)
+    {
+        return A.GetTypeID() < B.GetTypeID();
+    });
+
+    std::ofstream File(Path, std::ios::binary | std::ios::trunc);
+    if (!File)
+    {
+        LOG_ERROR_F("SaveRegion: can't open '%s'", Path.c_str());
+        return false;
+    }
+
+    RegionFileHeader Header;
+    for (size_t i = 0; i < Live.size(); ++i)
+    {
+        Header.BatchCount += (i == 0 || Live[i].GetTypeID() != Live[i - 1].GetTypeID()) ? 1 : 0;
+    }
+    File.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+
+    std::vector<uint8_t> Column;
+    for (size_t Begin = 0; Begin < Live.size();)
+    {
+        const ClassID ID = Live[Begin].GetTypeID();
+        size_t End = Begin;
+        while (End < Live.size() && Live[End].GetTypeID() == ID)
+        {
+            ++End;
+        }
+
+        Archetype* ClassArch = ClassArchetypeCache[ID];
+        const RegionBatchHeader Batch{ID, static_cast<uint32_t>(End - Begin),
+                                      static_cast<uint32_t>(ClassArch->FieldArrayTemplateCache.size())};
+        File.write(reinterpret_cast<const char*>(&Batch), sizeof(Batch));
+        for (const Archetype::FieldArrayTemplate& Field : ClassArch->FieldArrayTemplateCache)
+        {
+            const uint32_t ElementSize = static_cast<uint32_t>(Field.elementSize);
+            File.write(reinterpret_cast<const char*>(&ElementSize), sizeof(ElementSize));
+        }
+
+        // Rows may live in other archetypes (components added at runtime), only the class layout is written
+        for (size_t FieldIdx = 0; FieldIdx < ClassArch->CachedFieldArrayLayout.size(); ++FieldIdx)
+        {
+            const Archetype::FieldArrayDescriptor& Desc = ClassArch->CachedFieldArrayLayout[FieldIdx];
+            const size_t ElementSize = ClassArch->FieldArrayTemplateCache[FieldIdx].elementSize;
+            Column.assign((End - Begin) * ElementSize, 0);
+            for (size_t i = Begin; i < End; ++i)
+            {
+                EntityRecord* Record = FindRecord(Live[i]);
+                Archetype* Src = Record->Arch;
+                void* SrcArray = Desc.isDecomposed
+                                     ? Src->GetFieldArray(Record->TargetChunk, Desc.componentID, Desc.fieldIndex)
+                                     : Src->GetComponentArrayRaw(Record->TargetChunk, Desc.componentID);
+                if (SrcArray)
+                {
+                    std::memcpy(Column.data() + (i - Begin) * ElementSize,
+                                static_cast<uint8_t*>(SrcArray) + Src->GetElementIndex(Record->Index, ElementSize) * ElementSize,
+                                ElementSize);
+                }
+            }
+            File.write(reinterpret_cast<const char*>(Column.data()), static_cast<std::streamsize>(Column.size()));
+        }
+        Begin = End;
+    }
+
+    return static_cast<bool>(File);
+}
+
+uint32_t Registry::StageRegion(const uint8_t* Data, size_t Size)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    size_t Cursor = 0;
+    auto Read = [&](void* Out, size_t Bytes)
+    {
+        if (Bytes > Size - Cursor)
+            return false;
+        std::memcpy(Out, Data + Cursor, Bytes);
+        Cursor += Bytes;
+        return true;
+    };
+
+    RegionFileHeader Header;
+    if (!Read(&Header, sizeof(Header)) || Header.Magic != RegionFileHeader::MAGIC ||
+        Header.Version != RegionFileHeader::VERSION)
+    {
+        LOG_ERROR("StageRegion: not a region file (or another version)");
+        return 0;
+    }
+
+    ChunkAllocator& Allocator = ChunkAllocator::Get();
+    std::vector<StagedRun> Runs;
+    std::vector<uint32_t> ElementSizes;
+    uint32_t StagedCount = 0;
+    for (uint32_t BatchIdx = 0; BatchIdx < Header.BatchCount; ++BatchIdx)
+    {
+        RegionBatchHeader Batch;
+        if (!Read(&Batch, sizeof(Batch)) || Batch.FieldArrayCount > (Size - Cursor) / sizeof(uint32_t))
+        {
+            LOG_ERROR_F("StageRegion: truncated batch %u", BatchIdx);
+            break;
+        }
+
+        ElementSizes.resize(Batch.FieldArrayCount);
+        Read(ElementSizes.data(), ElementSizes.size() * sizeof(uint32_t));
+        uint64_t ArrayBytes = 0;
+        for (uint32_t ElementSize : ElementSizes)
+        {
+            ArrayBytes += static_cast<uint64_t>(ElementSize) * Batch.RowCount;
+        }
+        if (ArrayBytes > Size - Cursor)
+        {
+            LOG_ERROR_F("StageRegion: truncated batch %u", BatchIdx);
+            break;
+        }
+        const uint8_t* Arrays = Data + Cursor;
+        Cursor += ArrayBytes;
+
+        // Class archetypes are all built on construction, the cache is only read here
+        Archetype* Arch = Batch.ClassID < ClassArchetypeCache.size() ? ClassArchetypeCache[Batch.ClassID] : nullptr;
+        bool bLayoutMatches = Arch && !Arch->bTransient && ElementSizes.size() == Arch->FieldArrayTemplateCache.size();
+        for (size_t FieldIdx = 0; bLayoutMatches && FieldIdx < ElementSizes.size(); ++FieldIdx)
+        {
+            bLayoutMatches = ElementSizes[FieldIdx] == Arch->FieldArrayTemplateCache[FieldIdx].elementSize;
+        }
+        if (!bLayoutMatches)
+        {
+            LOG_ERROR_F("StageRegion: batch of class %u doesn't match this build's layout, skipped", Batch.ClassID);
+            continue;
+        }
+        if (Batch.RowCount == 0)
+            continue;
+
+        const uint32_t FirstIndex = EntityIndex.ReserveRange(Batch.RowCount);
+        if (FirstIndex == 0)
+        {
+            LOG_ERROR("StageRegion: out of entity indices");
+            break;
+        }
+
+        StagedRun Run{Arch, static_cast<ClassID>(Batch.ClassID), {}, Batch.RowCount, FirstIndex};
+        const uint32_t PerChunk = Arch->EntitiesPerChunk;
+        for (uint32_t First = 0, ChunkIdx = 0; First < Batch.RowCount; First += PerChunk, ++ChunkIdx)
+        {
+            const uint32_t Count = std::min(PerChunk, Batch.RowCount - First);
+            Chunk* Staging = Allocator.Allocate(Allocator.SelectNode(Arch->ArchClassID, ChunkIdx));
+            Staging->GetHeader().SharedSet = Arch->SharedSet;
+
+            // Fresh indices always start at generation 1
+            EntityID* ChunkIds = Arch->GetEntityIDs(Staging);
+            for (uint32_t i = 0; i < Count; ++i)
+            {
+                EntityID Id;
+                Id.Value = 0;
+                Id.Index = FirstIndex + First + i;
+                Id.Generation = 1;
+                Id.TypeID = Batch.ClassID;
+                ChunkIds[i] = Id;
+
+                EntityRecord& Record = EntityIndex.Ensure(Id.GetIndex());
+                Record.Arch = Arch;
+                Record.TargetChunk = Staging;
+                Record.ChunkIndex = ChunkIdx;
+                Record.Index = static_cast<ChunkRow>(i);
+                Record.Generation = 1;
+            }
+
+            const uint8_t* Array = Arrays;
+            for (size_t FieldIdx = 0; FieldIdx < ElementSizes.size(); ++FieldIdx)
+            {
+                const size_t ElementSize = ElementSizes[FieldIdx];
+                const uint8_t* Cursor = Array + First * ElementSize;
+                Arch->ForEachFieldRun(Staging, FieldIdx, 0, Count, [&](uint8_t* Elements, uint32_t Rows)
+                {
+                    std::memcpy(Elements, Cursor, Rows * ElementSize);
+                    Cursor += Rows * ElementSize;
+                });
+                Array += ElementSize * Batch.RowCount;
+            }
+            Run.Chunks.push_back(Staging);
+        }
+
+        StagedCount += Batch.RowCount;
+        Runs.push_back(std::move(Run));
+    }
+
+    // The whole region joins at the same sync point
+    std::lock_guard<std::mutex> Lock(StagingMutex);
+    for (StagedRun& Run : Runs)
+    {
+        StagedRuns.push_back(std::move(Run));
+    }
+    return StagedCount;
+}
+
+void Registry::SpliceStagedRuns()
+{
+    std::vector<StagedRun> Runs;
+    {
+        std::lock_guard<std::mutex> Lock(StagingMutex);
+        Runs.swap(StagedRuns);
+    }
+    if (Runs.empty())
+        return;
+
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    MetaRegistry& MR = MetaRegistry::Get();
+    for (const StagedRun& Run : Runs)
+    {
+        Archetype* Arch = Run.Arch;
+        const uint32_t FirstRow = Arch->TotalEntityCount;
+        uint32_t MoveCount;
+        const uint32_t FirstChunk = Arch->SpliceChunks(Run.Chunks, Run.RowCount, MoveCount);
+
+        // Rows in chunks that were taken over whole didn't move, their records only need the chunk index rebased
+        for (uint32_t Row = 0; Row < Run.RowCount - MoveCount; ++Row)
+        {
+            EntityIndex[Run.FirstIndex + Row].ChunkIndex += FirstChunk;
+        }
+
+        // The few rows that topped up the old tail chunk
+        for (uint32_t i = 0; i < MoveCount; ++i)
+        {
+            Archetype::EntitySlot Slot = Arch->GetSlot(FirstRow + i);
+            WriteRecord(Arch->GetEntityIDs(Slot.TargetChunk)[Slot.LocalIndex], Arch, Slot);
+        }
+
+        // New rows are [FirstRow, FirstRow + RowCount): the topped-up tail, then the spliced chunks
+        if (UpdateFunc OnCreate = MR.EntityGetters[Run.ID].OnCreate)
+        {
+            InvokeRowHook(Arch, OnCreate, FirstRow, Run.RowCount);
+        }
+    }
+}
+
+void Registry::ReleaseStagedRuns()
+{
+    std::lock_guard<std::mutex> Lock(StagingMutex);
+    for (StagedRun& Run : StagedRuns)
+    {
+        for (Chunk* Staging : Run.Chunks)
+        {
+            ChunkAllocator::Get().Free(Staging);
+        }
+    }
+    StagedRuns.clear();
+}
+
+void Registry::PageOutIdleChunks()
+{
+    if (PageOutSeconds == 0)
+        return;
+
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    PagingClock = static_cast<uint32_t>(
+        std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - PagingEpoch).count());
+
+    std::vector<uint8_t> Packed;
+    for (auto& [key, arch] : Archetypes)
+    {
+        if (!arch->bDormant)
+            continue;
+
+        // The tail chunk takes every push and pop, it stays resident
+        for (uint32_t ChunkIdx = 0; ChunkIdx + 1 < arch->Chunks.size(); ++ChunkIdx)
+        {
+            Chunk* Idle = arch->Chunks[ChunkIdx];
+            if (!Idle || PagingClock - Idle->GetHeader().LastTouched < PageOutSeconds)
+                continue;
+
+            // Records keep Arch/ChunkIndex/Index, a null TargetChunk marks them paged out
+            const EntityID* Ids = arch->GetEntityIDs(Idle);
+            for (uint32_t i = 0, Rows = arch->GetChunkCount(ChunkIdx); i < Rows; ++i)
+            {
+                EntityIndex[Ids[i].GetIndex()].TargetChunk = nullptr;
+            }
+
+            arch->PageOutChunk(ChunkIdx, Packed);
+            arch->PagedChunks[ChunkIdx] = Pager.Write(Packed);
+        }
+    }
+    STRIGID_PLOT("Paged Chunks", static_cast<int64_t>(Pager.GetPageCount()));
+}
+
+void Registry::PageIn(Archetype* Arch, uint32_t ChunkIndex)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    std::lock_guard<std::mutex> Lock(PagingMutex);
+    auto It = Arch->PagedChunks.find(ChunkIndex);
+    if (It == Arch->PagedChunks.end())
+        return; // Another thread paged it in first
+
+    std::vector<uint8_t> Packed;
+    if (!Pager.Read(It->second, Packed))
+    {
+        // The rows still count towards the archetype and its neighbours swap into them, there is nothing sane
+        // to install in their place
+        LOG_FATAL_F("Paging: chunk %u of archetype '%s' couldn't be read back", ChunkIndex, Arch->DebugName);
+        std::abort();
+    }
+
+    Chunk* Resident = Arch->PageInChunk(ChunkIndex, Packed);
+    Resident->GetHeader().LastTouched = PagingClock;
+
+    const EntityID* Ids = Arch->GetEntityIDs(Resident);
+    for (uint32_t i = 0, Rows = Arch->GetChunkCount(ChunkIndex); i < Rows; ++i)
+    {
+        EntityIndex[Ids[i].GetIndex()].TargetChunk = Resident;
+    }
+}
+
+void Registry::EnsureTailResident(Archetype* Arch)
+{
+    if (!Arch->PagedChunks.empty() && !Arch->Chunks.empty() && !Arch->Chunks.back())
+    {
+        PageIn(Arch, static_cast<uint32_t>(Arch->Chunks.size() - 1));
+    }
+}
+
+SparseSet* Registry::GetSparseSet(ComponentTypeID TypeID, bool bCreate)
+{
+    if (TypeID >= SparseSets.size())
+    {
+        if (!bCreate)
+            return nullptr;
+        SparseSets.resize(TypeID + 1);
+    }
+
+    if (!SparseSets[TypeID] && bCreate)
+    {
+        const ComponentMetaEx& Meta = ComponentFieldRegistry::Get().GetComponentMeta(TypeID);
+        SparseSets[TypeID] = std::make_unique<SparseSet>(TypeID, Meta.Size);
+    }
+    return SparseSets[TypeID].get();
+}
+
+void Registry::RemoveRow(const EntityRecord& Record)
+{
+    Archetype* Arch = Record.Arch;
+    EnsureTailResident(Arch);
+    const uint32_t ChunkIndex = Record.ChunkIndex;
+    const uint32_t LocalIndex = Record.Index;
+
+    EntityID Moved = Arch->RemoveEntity(ChunkIndex, LocalIndex);
+    if (Moved.IsValid())
+    {
+        EntityRecord& MovedRecord = EntityIndex[Moved.GetIndex()];
+        MovedRecord.TargetChunk = Arch->Chunks[ChunkIndex];
+        MovedRecord.ChunkIndex = ChunkIndex;
+        MovedRecord.Index = static_cast<ChunkRow>(LocalIndex);
+    }
+}
+
+void Registry::MigrateEntity(EntityID Id, ComponentTypeID TypeID, bool bAdd)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+
+    EntityRecord* Record = FindRecord(Id);
+    if (!Record)
+        return;
+
+    Archetype* Src = Record->Arch;
+    if (Src->ArchSignature.Has(TypeID - 1) == bAdd)
+        return; // Already in the requested state
+
+    if (Src->bTransient)
+    {
+        LOG_WARN_F("Add/RemoveComponent: class %u is transient, ignored", Id.GetTypeID());
+        return;
+    }
+
+    // The entity's own class, Src may be shared by several (merged archetypes)
+    const ClassID EntityClass = Id.GetTypeID();
+    if (!bAdd)
+    {
+        const std::vector<ComponentTypeID>& Schema = MetaRegistry::Get().ClassToComponentList[EntityClass];
+        if (std::find(Schema.begin(), Schema.end(), TypeID) != Schema.end())
+        {
+            LOG_WARN_F("RemoveComponent: component %u is part of class %u's schema, ignored", TypeID,
+                       EntityClass);
+            return;
+        }
+    }
+
+    const bool bShared = ComponentFieldRegistry::Get().IsShared(TypeID);
+    if (bAdd && bShared)
+    {
+        LOG_WARN_F("AddComponent: component %u is shared, use SetShared to give it a value", TypeID);
+        return;
+    }
+
+    // Cached transition, except from merged archetypes where the target depends on the entity's class
+    Archetype* Dst = nullptr;
+    Archetype** CachedDst = nullptr;
+    if (!Src->bMergedClasses)
+    {
+        CachedDst = bAdd ? &Src->AddEdges[TypeID] : &Src->RemoveEdges[TypeID];
+        Dst = *CachedDst;
+    }
+    if (!Dst)
+    {
+        Signature DstSig = Src->ArchSignature;
+        if (bAdd) DstSig.Set(TypeID - 1);
+        else DstSig.Clear(TypeID - 1);
+
+        // Removing a shared component drops its value, other shared values stay
+        const uint32_t DstSet = bShared ? SharedValues.WithoutType(Src->SharedSet, TypeID) : Src->SharedSet;
+        Dst = GetOrCreateArchetype(DstSig, EntityClass, DstSet, Src->bDormant);
+        if (CachedDst)
+            *CachedDst = Dst;
+    }
+
+    MoveToArchetype(Id, *Record, Dst);
+}
+
+void Registry::ApplySharedValue(EntityID Id, uint32_t ValueHandle)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+
+    EntityRecord* Record = FindRecord(Id);
+    if (!Record)
+        return;
+
+    Archetype* Src = Record->Arch;
+    if (Src->bTransient)
+    {
+        LOG_WARN_F("SetShared: class %u is transient, ignored", Id.GetTypeID());
+        return;
+    }
+
+    const uint32_t DstSet = SharedValues.WithValue(Src->SharedSet, ValueHandle);
+    if (DstSet == Src->SharedSet)
+        return; // Already has this value
+
+    Signature DstSig = Src->ArchSignature;
+    DstSig.Set(SharedValues.GetValueType(ValueHandle) - 1);
+    MoveToArchetype(Id, *Record, GetOrCreateArchetype(DstSig, Id.GetTypeID(), DstSet, Src->bDormant));
+}
+
+void Registry::MoveToArchetype(EntityID Id, EntityRecord& Record, Archetype* Dst)
+{
+    Archetype* Src = Record.Arch;
+    EnsureTailResident(Dst);
+    Archetype::EntitySlot Slot = Dst->PushEntity(Id);
+    if (Dst->bDormant)
+    {
+        Slot.TargetChunk->GetHeader().LastTouched = PagingClock;
+    }
+    Archetype::CopyRowBetween(*Src, Record.TargetChunk, Record.Index, *Dst, Slot.TargetChunk, Slot.LocalIndex);
+
+    RemoveRow(Record);
+    WriteRecord(Id, Dst, Slot);
+}
+
+std::vector<ComponentMetaEx> Registry::BuildComponentList(const Signature& Sig, ClassID ID)
+{
+    MetaRegistry& MR = MetaRegistry::Get();
+    ComponentFieldRegistry& CFR = ComponentFieldRegistry::Get();
+
+    std::vector<ComponentMetaEx> Components;
+    Signature Remaining = Sig;
+
+    // Schema components first, in schema order, EntityView::Hydrate binds by position
+    auto SchemaIt = MR.ClassToComponentList.find(ID);
+    if (SchemaIt != MR.ClassToComponentList.end())
+    {
+        for (ComponentTypeID CompID : SchemaIt->second)
+        {
+            if (Sig.Has(CompID - 1))
+            {
+                Components.push_back(CFR.GetComponentMeta(CompID));
+                Remaining.Clear(CompID - 1);
+            }
+        }
+    }
+
+    // Components added at runtime, appended in TypeID order
+    for (size_t Bit = 0; Bit < MAX_COMPONENTS && Remaining.Count() > 0; ++Bit)
+    {
+        if (Remaining.Has(static_cast<ComponentTypeID>(Bit)))
+        {
+            Components.push_back(CFR.GetComponentMeta(static_cast<ComponentTypeID>(Bit + 1)));
+            Remaining.Clear(static_cast<ComponentTypeID>(Bit));
+        }
+    }
+
+    return Components;
+}
+
+void Registry::InitializeArchetypes()
+{
+    MetaRegistry& MR = MetaRegistry::Get();
+    // One archetype per class, classes with the same storage can be combined afterwards (MergeClassArchetypes)
+
+    for (auto& Arch : MR.ClassToArchetype)
+    {
+        auto key = Archetype::ArchetypeKey(Arch.second, Arch.first);
+        Archetype*& NewArch = Archetypes[key];
+        if (!NewArch)
+        {
+            NewArch = CreateArchetype(key);
+        }
+        ClassArchetypeCache[Arch.first] = NewArch;
+    }
+}
+
+void Registry::MergeClassArchetypes()
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    MetaRegistry& MR = MetaRegistry::Get();
+
+    // Lowest ClassID of each group owns the archetype, so the result doesn't depend on map order
+    std::vector<ClassID> Classes;
+    for (const auto& [ID, Sig] : MR.ClassToArchetype)
+    {
+        Classes.push_back(ID);
+    }
+    std::sort(Classes.begin(), Classes.end());
+
+    // Classes can only share rows if their field arrays are laid out alike (schema order decides
+    // hydration order) and their template rows match
+    auto SameStorage = [&MR](ClassID A, ClassID B)
+    {
+        auto DefaultsA = MR.ClassToDefaults.find(A);
+        auto DefaultsB = MR.ClassToDefaults.find(B);
+        const bool bHasA = DefaultsA != MR.ClassToDefaults.end();
+        const bool bHasB = DefaultsB != MR.ClassToDefaults.end();
+        return MR.ClassToComponentList[A] == MR.ClassToComponentList[B] && bHasA == bHasB &&
+            (!bHasA || DefaultsA->second == DefaultsB->second);
+    };
+
+    std::unordered_map<Signature, std::vector<ClassID>> Owners;
+    uint32_t MergedClassCount = 0;
+    for (ClassID ID : Classes)
+    {
+        if (MR.EntityGetters[ID].TransientLifetime > 0)
+            continue; // Rings expire by position, rows of other classes can't sit in one
+        if (MR.EntityGetters[ID].bBlockedLayout)
+            continue; // Class runs start anywhere, a blocked kernel call has to start on a block
+
+        const Signature Sig = MR.ClassToArchetype[ID];
+        std::vector<ClassID>& Candidates = Owners[Sig];
+        auto Owner = std::find_if(Candidates.begin(), Candidates.end(), [&](ClassID Other)
+        {
+            return SameStorage(Other, ID);
+        });
+
+        if (Owner == Candidates.end())
+        {
+            Candidates.push_back(ID);
+            continue;
+        }
+
+        // The class's own archetype was just created by InitializeArchetypes and is still empty
+        Archetype* Shared = ClassArchetypeCache[*Owner];
+        auto Own = Archetypes.find(Archetype::ArchetypeKey(Sig, ID));
+        if (Own != Archetypes.end())
+        {
+            delete Own->second;
+            Archetypes.erase(Own);
+        }
+        ClassArchetypeCache[ID] = Shared;
+
+        if (!Shared->bMergedClasses)
+        {
+            Shared->bMergedClasses = true;
+            MergedArchetypes.push_back(Shared);
+        }
+        ++MergedClassCount;
+    }
+
+    LOG_INFO_F("Merged %u classes into %zu shared archetypes", MergedClassCount, MergedArchetypes.size());
+}
+
+void Registry::SortClassRuns()
+{
+    for (Archetype* Arch : MergedArchetypes)
+    {
+        if (!Arch->NeedsClassSort())
+            continue;
+
+        ClassSortMovedRows.clear();
+        Arch->SortClassRuns(ClassSortMovedRows);
+        for (uint32_t Row : ClassSortMovedRows)
+        {
+            Archetype::EntitySlot Slot = Arch->GetSlot(Row);
+            WriteRecord(Arch->GetEntityIDs(Slot.TargetChunk)[Slot.LocalIndex], Arch, Slot);
+        }
+    }
+}
+
+void Registry::ResetRegistry()
+{
+    std::unique_lock<std::shared_mutex> AppendLock(ConcurrentAppendMutex);
+
+    EntityIndex.Reset();
+    while (!FreeIndices.empty())
+    {
+        FreeIndices.pop();
+    }
+    for (uint32_t Slot = 0; Slot < JobSystem::MAX_THREAD_SLOTS; ++Slot)
+    {
+        CommandBuffers[Slot].Reset();
+    }
+    PendingIds.Reset();
+    for (auto& [key, arch] : Archetypes)
+    {
+        arch->Clear();
+    }
+    for (std::unique_ptr<SparseSet>& Set : SparseSets)
+    {
+        if (Set)
+            Set->Clear();
+    }
+    Pager.Reset();
+    ReleaseStagedRuns();
+
+    for (uint32_t Slot = 0; Slot < BehaviorSlots.size(); ++Slot)
+    {
+        if (BehaviorSlots[Slot].Coroutine)
+            DestroyBehavior(Slot);
+    }
+    EventWaiters.clear();
+
+    for (std::unique_ptr<FieldIndexState>& State : FieldIndexes)
+    {
+        State->Index.Clear();
+        State->Sources.clear();
+        State->KnownArchetypes = 0;
+    }
+
+    std::lock_guard<std::mutex> TimerLock(TimerMutex);
+    Timers.Clear();
+}
+
+uint32_t Registry::GetTotalChunkCount() const
+{
+    uint32_t totalChunks = 0;
+    for (const auto& [sig, archetype] : Archetypes)
+    {
+        totalChunks += static_cast<uint32_t>(archetype->Chunks.size());
+    }
+    return totalChunks;
+}
+
+uint32_t Registry::GetTotalEntityCount() const
+{
+    uint32_t totalEntities = 0;
+    for (const auto& [sig, archetype] : Archetypes)
+    {
+        totalEntities += archetype->TotalEntityCount;
+    }
+    return totalEntities;
+}
+
+uint64_t Registry::ComputeStateChecksum()
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_LOGIC);
+
+    // Archetype map order isn't stable across runs, visit them by key instead
+    std::vector<Archetype*> Archs;
+    for (const auto& [Key, Arch] : Archetypes)
+    {
+        if (!Key.Dormant && Arch->TotalEntityCount > 0)
+            Archs.push_back(Arch);
+    }
+    std::sort(Archs.begin(), Archs.end(), [](const Archetype* A, const Archetype* B)
+    {
+        if (A->ArchClassID != B->ArchClassID)
+            return A->ArchClassID < B->ArchClassID;
+        if (A->SharedSet != B->SharedSet)
+            return A->SharedSet < B->SharedSet;
+        const uint64_t* BitsA = reinterpret_cast<const uint64_t*>(&A->ArchSignature);
+        const uint64_t* BitsB = reinterpret_cast<const uint64_t*>(&B->ArchSignature);
+        return std::lexicographical_compare(BitsA, BitsA + MAX_COMPONENTS / 64, BitsB, BitsB + MAX_COMPONENTS / 64);
+    });
+
+    struct ChecksumJob
+    {
+        Archetype* Arch;
+        uint32_t ChunkIndex;
+        uint32_t FirstHotField; // Into HotFields
+        uint32_t HotFieldCount;
+    };
+
+    const ComponentFieldRegistry& CFR = ComponentFieldRegistry::Get();
+    std::vector<uint32_t> HotFields; // Field table indices, per archetype
+    std::vector<ChecksumJob> Jobs;
+    std::vector<uint8_t> JobNodes;
+    for (Archetype* Arch : Archs)
+    {
+        const uint32_t FirstHotField = static_cast<uint32_t>(HotFields.size());
+        for (size_t i = 0; i < Arch->CachedFieldArrayLayout.size(); ++i)
+        {
+            if (CFR.IsHot(Arch->CachedFieldArrayLayout[i].componentID))
+                HotFields.push_back(static_cast<uint32_t>(i));
+        }
+        const uint32_t HotFieldCount = static_cast<uint32_t>(HotFields.size()) - FirstHotField;
+
+        for (size_t chunkIdx = 0; chunkIdx < Arch->Chunks.size(); ++chunkIdx)
+        {
+            if (!Arch->Chunks[chunkIdx] || Arch->GetChunkCount(chunkIdx) == 0)
+                continue;
+            Jobs.push_back({Arch, static_cast<uint32_t>(chunkIdx), FirstHotField, HotFieldCount});
+            JobNodes.push_back(static_cast<uint8_t>(Arch->Chunks[chunkIdx]->GetHeader().NumaNode));
+        }
+    }
+
+    // Each job hashes its chunk's live rows field by field, in row order whatever the layout (ring head, blocks)
+    std::vector<uint64_t> ChunkHashes(Jobs.size());
+    JobSystem::Get().ParallelFor(static_cast<uint32_t>(Jobs.size()), [&](uint32_t JobIndex)
+    {
+        const ChecksumJob& Job = Jobs[JobIndex];
+        Archetype* Arch = Job.Arch;
+        Chunk* TargetChunk = Arch->Chunks[Job.ChunkIndex];
+        const uint32_t FirstRow = Arch->GetChunkFirstRow(Job.ChunkIndex);
+        const uint32_t Count = Arch->GetChunkCount(Job.ChunkIndex);
+
+        LaneHasher Hasher;
+        Hasher.Update(reinterpret_cast<const uint8_t*>(&Count), sizeof(Count));
+        Hasher.Update(reinterpret_cast<const uint8_t*>(Arch->GetEntityIDs(TargetChunk) + FirstRow),
+                      Count * sizeof(EntityID));
+        for (uint32_t i = 0; i < Job.HotFieldCount; ++i)
+        {
+            const uint32_t FieldIdx = HotFields[Job.FirstHotField + i];
+            const size_t ElementSize = Arch->FieldArrayTemplateCache[FieldIdx].elementSize;
+            Arch->ForEachFieldRun(TargetChunk, FieldIdx, FirstRow, Count, [&](uint8_t* Elements, uint32_t Rows)
+            {
+                Hasher.Update(Elements, Rows * ElementSize);
+            });
+        }
+        ChunkHashes[JobIndex] = Hasher.Finish();
+    }, JobNodes.data());
+
+    uint64_t Checksum = LaneHasher::PRIME64;
+    for (uint64_t ChunkHash : ChunkHashes)
+    {
+        Checksum = (Checksum ^ ChunkHash) * LaneHasher::PRIME64;
+        Checksum ^= Checksum >> 32;
+    }
+    return Checksum;
 }
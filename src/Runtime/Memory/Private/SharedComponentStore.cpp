@@ -0,0 +1,112 @@
+#include "SharedComponentStore.h"
+
+#include <algorithm>
+#include <mutex>
+
+SharedComponentStore::SharedComponentStore()
+{
+    // Reserved "none" entries
+    Values.push_back({0, {}});
+    Sets.emplace_back();
+    SetLookup[{}] = 0;
+}
+
+uint32_t SharedComponentStore::InternValue(ComponentTypeID TypeID, const void* Data, size_t Size)
+{
+    std::pair<ComponentTypeID, std::string> Key{TypeID, std::string(static_cast<const char*>(Data), Size)};
+
+    {
+        std::shared_lock<std::shared_mutex> Lock(Mutex);
+        auto It = ValueLookup.find(Key);
+        if (It != ValueLookup.end())
+            return It->second;
+    }
+
+    std::unique_lock<std::shared_mutex> Lock(Mutex);
+    auto [It, bInserted] = ValueLookup.try_emplace(Key, static_cast<uint32_t>(Values.size()));
+    if (bInserted)
+    {
+        Values.push_back({TypeID, std::move(Key.second)});
+    }
+    return It->second;
+}
+
+uint32_t SharedComponentStore::WithValue(uint32_t SetIndex, uint32_t ValueHandle)
+{
+    std::unique_lock<std::shared_mutex> Lock(Mutex);
+    const ComponentTypeID TypeID = Values[ValueHandle].TypeID;
+
+    std::vector<uint32_t> Handles = Sets[SetIndex];
+    auto It = std::lower_bound(Handles.begin(), Handles.end(), TypeID, [this](uint32_t Handle, ComponentTypeID Type)
+    {
+        return Values[Handle].TypeID < Type;
+    });
+
+    if (It != Handles.end() && Values[*It].TypeID == TypeID)
+    {
+        if (*It == ValueHandle)
+            return SetIndex;
+        *It = ValueHandle;
+    }
+    else
+    {
+        Handles.insert(It, ValueHandle);
+    }
+    return InternSet(std::move(Handles));
+}
+
+uint32_t SharedComponentStore::WithoutType(uint32_t SetIndex, ComponentTypeID TypeID)
+{
+    std::unique_lock<std::shared_mutex> Lock(Mutex);
+    std::vector<uint32_t> Handles = Sets[SetIndex];
+    auto It = std::find_if(Handles.begin(), Handles.end(), [this, TypeID](uint32_t Handle)
+    {
+        return Values[Handle].TypeID == TypeID;
+    });
+
+    if (It == Handles.end())
+        return SetIndex;
+
+    Handles.erase(It);
+    return InternSet(std::move(Handles));
+}
+
+const void* SharedComponentStore::Find(uint32_t SetIndex, ComponentTypeID TypeID) const
+{
+    const uint32_t Handle = FindHandle(SetIndex, TypeID);
+    if (Handle == 0)
+        return nullptr;
+
+    std::shared_lock<std::shared_mutex> Lock(Mutex);
+    return Values[Handle].Bytes.data();
+}
+
+uint32_t SharedComponentStore::FindHandle(uint32_t SetIndex, ComponentTypeID TypeID) const
+{
+    std::shared_lock<std::shared_mutex> Lock(Mutex);
+    if (SetIndex >= Sets.size())
+        return 0;
+
+    for (uint32_t Handle : Sets[SetIndex])
+    {
+        if (Values[Handle].TypeID == TypeID)
+            return Handle;
+    }
+    return 0;
+}
+
+ComponentTypeID SharedComponentStore::GetValueType(uint32_t ValueHandle) const
+{
+    std::shared_lock<std::shared_mutex> Lock(Mutex);
+    return ValueHandle < Values.size() ? Values[ValueHandle].TypeID : 0;
+}
+
+uint32_t SharedComponentStore::InternSet(std::vector<uint32_t>&& Handles)
+{
+    auto [It, bInserted] = SetLookup.try_emplace(Handles, static_cast<uint32_t>(Sets.size()));
+    if (bInserted)
+    {
+        Sets.push_back(std::move(Handles));
+    }
+    return It->second;
+}
@@ -0,0 +1,90 @@
+#include "SparseSet.h"
+
+#include <cstring>
+
+SparseSet::SparseSet(ComponentTypeID InTypeID, size_t InElementSize)
+    : TypeID(InTypeID)
+      , ElementSize(InElementSize)
+{
+}
+
+uint32_t* SparseSet::SparseSlot(uint32_t Index, bool bAllocate)
+{
+    const uint32_t Page = Index >> PAGE_SHIFT;
+    if (Page >= SparsePages.size())
+    {
+        if (!bAllocate)
+            return nullptr;
+        SparsePages.resize(Page + 1);
+    }
+
+    if (!SparsePages[Page])
+    {
+        if (!bAllocate)
+            return nullptr;
+        SparsePages[Page] = std::make_unique<uint32_t[]>(PAGE_SIZE);
+    }
+
+    return &SparsePages[Page][Index & (PAGE_SIZE - 1)];
+}
+
+void* SparseSet::Find(EntityID Id)
+{
+    const uint32_t* Slot = SparseSlot(Id.GetIndex(), false);
+    if (!Slot || *Slot == 0)
+        return nullptr;
+
+    // The slot is shared by every generation of the index, the dense ID tells them apart
+    const uint32_t DenseIndex = *Slot - 1;
+    return DenseIds[DenseIndex] == Id ? GetDenseValue(DenseIndex) : nullptr;
+}
+
+void* SparseSet::Emplace(EntityID Id)
+{
+    uint32_t* Slot = SparseSlot(Id.GetIndex(), true);
+    if (*Slot != 0)
+    {
+        const uint32_t DenseIndex = *Slot - 1;
+        if (DenseIds[DenseIndex] == Id)
+            return GetDenseValue(DenseIndex);
+
+        // Left behind by an older generation, reuse the dense element
+        DenseIds[DenseIndex] = Id;
+        std::memset(GetDenseValue(DenseIndex), 0, ElementSize);
+        return GetDenseValue(DenseIndex);
+    }
+
+    DenseIds.push_back(Id);
+    DenseValues.resize(DenseValues.size() + ElementSize, 0);
+    *Slot = static_cast<uint32_t>(DenseIds.size());
+    return GetDenseValue(*Slot - 1);
+}
+
+bool SparseSet::Remove(EntityID Id)
+{
+    uint32_t* Slot = SparseSlot(Id.GetIndex(), false);
+    if (!Slot || *Slot == 0 || DenseIds[*Slot - 1] != Id)
+        return false;
+
+    const uint32_t DenseIndex = *Slot - 1;
+    const uint32_t LastIndex = static_cast<uint32_t>(DenseIds.size()) - 1;
+    if (DenseIndex != LastIndex)
+    {
+        // Swap the last element into the hole and repoint its sparse slot
+        DenseIds[DenseIndex] = DenseIds[LastIndex];
+        std::memcpy(GetDenseValue(DenseIndex), GetDenseValue(LastIndex), ElementSize);
+        *SparseSlot(DenseIds[DenseIndex].GetIndex(), false) = DenseIndex + 1;
+    }
+
+    *Slot = 0;
+    DenseIds.pop_back();
+    DenseValues.resize(DenseValues.size() - ElementSize);
+    return true;
+}
+
+void SparseSet::Clear()
+{
+    SparsePages.clear();
+    DenseIds.clear();
+    DenseValues.clear();
+}
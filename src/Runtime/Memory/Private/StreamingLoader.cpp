@@ -0,0 +1,87 @@
+#include "StreamingLoader.h"
+
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "Logger.h"
+#include "Profiler.h"
+#include "Registry.h"
+
+StreamingLoader::StreamingLoader(Registry& InTarget)
+    : Target(InTarget)
+{
+    Loader = std::thread(&StreamingLoader::LoaderMain, this);
+}
+
+StreamingLoader::~StreamingLoader()
+{
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        bStop = true;
+        Queue.clear();
+    }
+    QueueCondition.notify_one();
+    Loader.join();
+}
+
+void StreamingLoader::Request(const std::string& Path)
+{
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        Queue.push_back(Path);
+    }
+    QueueCondition.notify_one();
+}
+
+void StreamingLoader::WaitIdle()
+{
+    std::unique_lock<std::mutex> Lock(Mutex);
+    IdleCondition.wait(Lock, [this] { return Queue.empty() && !bBusy; });
+}
+
+uint32_t StreamingLoader::GetQueuedCount() const
+{
+    std::lock_guard<std::mutex> Lock(Mutex);
+    return static_cast<uint32_t>(Queue.size()) + (bBusy ? 1 : 0);
+}
+
+void StreamingLoader::LoaderMain()
+{
+    std::vector<uint8_t> Image;
+    for (;;)
+    {
+        std::string Path;
+        {
+            std::unique_lock<std::mutex> Lock(Mutex);
+            QueueCondition.wait(Lock, [this] { return bStop || !Queue.empty(); });
+            if (bStop)
+                return;
+
+            Path = std::move(Queue.front());
+            Queue.pop_front();
+            bBusy = true;
+        }
+
+        {
+            STRIGID_ZONE_N("StreamingLoader::Load");
+            std::ifstream File(Path, std::ios::binary);
+            if (File)
+            {
+                Image.assign(std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>());
+                const uint32_t Staged = Target.StageRegion(Image.data(), Image.size());
+                LOG_INFO_F("Streamed region '%s': %u entities staged", Path.c_str(), Staged);
+            }
+            else
+            {
+                LOG_ERROR_F("StreamingLoader: can't open region file '%s'", Path.c_str());
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> Lock(Mutex);
+            bBusy = false;
+        }
+        IdleCondition.notify_all();
+    }
+}
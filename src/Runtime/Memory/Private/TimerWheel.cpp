@@ -0,0 +1,149 @@
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+TimerWheel::TimerWheel()
+{
+    std::fill(std::begin(Buckets), std::end(Buckets), NIL);
+}
+
+TimerHandle TimerWheel::Insert(EntityID Id, uint32_t DelayTicks, uint32_t CallbackID, uint64_t Payload)
+{
+    uint32_t Index;
+    if (FreeHead != NIL)
+    {
+        Index = FreeHead;
+        FreeHead = Entries[Index].Next;
+    }
+    else
+    {
+        Index = static_cast<uint32_t>(Entries.size());
+        Entries.emplace_back();
+        Entries[Index].Generation = 1;
+    }
+
+    Entry& NewEntry = Entries[Index];
+    NewEntry.Id = Id;
+    NewEntry.Payload = Payload;
+    NewEntry.CallbackID = CallbackID;
+    NewEntry.Due = Now + std::max(DelayTicks, 1u);
+    Schedule(Index);
+    ++PendingCount;
+
+    return {Index, NewEntry.Generation};
+}
+
+bool TimerWheel::Cancel(TimerHandle Handle)
+{
+    if (Handle.Index >= Entries.size())
+        return false;
+
+    const Entry& Target = Entries[Handle.Index];
+    if (Target.Generation != Handle.Generation || Target.Bucket == NIL)
+        return false;
+
+    Unlink(Handle.Index);
+    Release(Handle.Index);
+    return true;
+}
+
+void TimerWheel::Advance(std::vector<TimerExpiry>& OutExpired)
+{
+    ++Now;
+
+    // Every level that turned over moves its current slot down, highest first so entries can fall through
+    uint32_t Top = 0;
+    while (Top + 1 < LEVELS && (Now & ((1u << ((Top + 1) * SLOT_BITS)) - 1)) == 0)
+    {
+        ++Top;
+    }
+
+    for (uint32_t Level = Top; Level >= 1; --Level)
+    {
+        const uint32_t Bucket = Level * SLOTS + ((Now >> (Level * SLOT_BITS)) & (SLOTS - 1));
+        uint32_t Cursor = Buckets[Bucket];
+        Buckets[Bucket] = NIL;
+        while (Cursor != NIL)
+        {
+            const uint32_t Next = Entries[Cursor].Next;
+            Schedule(Cursor);
+            Cursor = Next;
+        }
+    }
+
+    // Level 0 slots only ever hold timers due on the tick they're visited at
+    uint32_t Cursor = Buckets[Now & (SLOTS - 1)];
+    Buckets[Now & (SLOTS - 1)] = NIL;
+    while (Cursor != NIL)
+    {
+        const Entry& Due = Entries[Cursor];
+        const uint32_t Next = Due.Next;
+        OutExpired.push_back({Due.Id, Due.Payload, Due.CallbackID});
+        Release(Cursor);
+        Cursor = Next;
+    }
+}
+
+void TimerWheel::Clear()
+{
+    std::fill(std::begin(Buckets), std::end(Buckets), NIL);
+    for (uint32_t Index = 0; Index < Entries.size(); ++Index)
+    {
+        if (Entries[Index].Bucket != NIL)
+        {
+            Release(Index);
+        }
+    }
+    PendingCount = 0;
+}
+
+void TimerWheel::Schedule(uint32_t EntryIndex)
+{
+    Entry& Target = Entries[EntryIndex];
+
+    // Lowest level whose span covers the remaining delay
+    const uint32_t Delta = Target.Due - Now;
+    uint32_t Level = 0;
+    while (Level + 1 < LEVELS && Delta >= (1u << ((Level + 1) * SLOT_BITS)))
+    {
+        ++Level;
+    }
+
+    const uint32_t Bucket = Level * SLOTS + ((Target.Due >> (Level * SLOT_BITS)) & (SLOTS - 1));
+    Target.Bucket = Bucket;
+    Target.Prev = NIL;
+    Target.Next = Buckets[Bucket];
+    if (Target.Next != NIL)
+    {
+        Entries[Target.Next].Prev = EntryIndex;
+    }
+    Buckets[Bucket] = EntryIndex;
+}
+
+void TimerWheel::Unlink(uint32_t EntryIndex)
+{
+    const Entry& Target = Entries[EntryIndex];
+    if (Target.Prev != NIL)
+    {
+        Entries[Target.Prev].Next = Target.Next;
+    }
+    else
+    {
+        Buckets[Target.Bucket] = Target.Next;
+    }
+
+    if (Target.Next != NIL)
+    {
+        Entries[Target.Next].Prev = Target.Prev;
+    }
+}
+
+void TimerWheel::Release(uint32_t EntryIndex)
+{
+    Entry& Target = Entries[EntryIndex];
+    Target.Bucket = NIL;
+    Target.Generation = Target.Generation + 1 == 0 ? 1 : Target.Generation + 1;
+    Target.Next = FreeHead;
+    FreeHead = EntryIndex;
+    --PendingCount;
+}
@@ -0,0 +1,72 @@
+#include "ValueIndex.h"
+
+#include <cassert>
+
+void ValueIndex::Apply(std::vector<Entry>& Removed, std::vector<Entry>& Added)
+{
+    if (Removed.empty() && Added.empty())
+        return;
+
+    assert(Size + Added.size() >= Removed.size());
+    Size = Size + Added.size() - Removed.size();
+
+    if (Kind == ValueIndexKind::Hash)
+    {
+        for (const Entry& Gone : Removed)
+        {
+            auto Found = Buckets.find(Gone.Key);
+            assert(Found != Buckets.end());
+            std::vector<EntityID>& Ids = Found->second;
+            auto It = std::find(Ids.begin(), Ids.end(), Gone.Id);
+            assert(It != Ids.end());
+            *It = Ids.back();
+            Ids.pop_back();
+            if (Ids.empty())
+            {
+                Buckets.erase(Found);
+            }
+        }
+        for (const Entry& New : Added)
+        {
+            Buckets[New.Key].push_back(New.Id);
+        }
+        Removed.clear();
+        Added.clear();
+        return;
+    }
+
+    // One merge pass: drop the removed entries and interleave the added ones
+    std::sort(Removed.begin(), Removed.end());
+    std::sort(Added.begin(), Added.end());
+    MergeScratch.clear();
+    MergeScratch.reserve(Size);
+
+    size_t RemovedCursor = 0;
+    size_t AddedCursor = 0;
+    for (const Entry& Existing : Sorted)
+    {
+        if (RemovedCursor < Removed.size() && Removed[RemovedCursor] == Existing)
+        {
+            ++RemovedCursor;
+            continue;
+        }
+        while (AddedCursor < Added.size() && Added[AddedCursor] < Existing)
+        {
+            MergeScratch.push_back(Added[AddedCursor++]);
+        }
+        MergeScratch.push_back(Existing);
+    }
+    assert(RemovedCursor == Removed.size());
+    MergeScratch.insert(MergeScratch.end(), Added.begin() + AddedCursor, Added.end());
+
+    Sorted.swap(MergeScratch);
+    Removed.clear();
+    Added.clear();
+}
+
+void ValueIndex::Clear()
+{
+    Sorted.clear();
+    Buckets.clear();
+    Size = 0;
+}
@@ -2,7 +2,11 @@
 #include "Types.h"
 #include "Signature.h"
 #include "Chunk.h"
+#include <algorithm>
+#include <atomic>
+#include <deque>
 #include <vector>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -10,7 +14,7 @@
 #include "Schema.h"
 
 // Archetype - manages storage for entities with a specific component signature
-// Uses Structure-of-Arrays (SoA) layout within each chunk
+// Uses Structure-of-Arrays (SoA) layout within each chunk, or blocks of 8 rows per field (AoSoA) when the class asks
 class Archetype
 {
 public:
@@ -18,10 +22,12 @@ public:
     {
         Signature Sig;
         ClassID ID;
+        uint32_t SharedSet = 0; // Shared component values, entities with different values never share chunks
+        bool Dormant = false; // Deactivated entities live in their own chunks
 
         bool operator==(const ArchetypeKey& other) const
         {
-            return ID == other.ID && Sig == other.Sig;
+            return ID == other.ID && SharedSet == other.SharedSet && Dormant == other.Dormant && Sig == other.Sig;
         }
     };
 
@@ -35,6 +41,29 @@ public:
     // ClassID - needed for using the correct entity during Hydration
     ClassID ArchClassID;
 
+    // Shared component value set of every row, stamped into each chunk header (0 = none)
+    uint32_t SharedSet = 0;
+
+    // Holds deactivated entities (see Registry::Deactivate): lifecycle phases, queries and rendering skip it
+    bool bDormant = false;
+
+    // Same storage with the opposite dormancy, where Activate/Deactivate moves rows (created on first use)
+    Archetype* Twin = nullptr;
+
+    // Several classes share this archetype (see EngineConfig::bMergeSameSignatureClasses)
+    // ArchClassID is then the lowest of them, each row's own class is its EntityID TypeID
+    bool bMergedClasses = false;
+
+    // Rows of one class in a merged archetype, valid after SortClassRuns
+    struct ClassRun
+    {
+        ClassID ID;
+        uint32_t FirstRow;
+        uint32_t Count;
+    };
+
+    std::vector<ClassRun> ClassRuns;
+
     // Debug name for profiling
     const char* DebugName;
 
@@ -58,21 +87,209 @@ public:
 
     std::vector<ComponentCacheEntry> ComponentIterationCache;
 
-    // Get the number of entities in a specific chunk (handles tail chunk)
+    // Get the number of entities in a specific chunk (handles tail chunk and ring head), from GetChunkFirstRow on
     uint32_t GetChunkCount(size_t ChunkIndex) const;
 
+    // First live row of a chunk, only the head chunk of a transient ring starts past 0
+    uint32_t GetChunkFirstRow(size_t ChunkIndex) const { return ChunkIndex == 0 ? HeadRow : 0; }
+
     // Allocate a new entity slot (returns chunk and local index)
     struct EntitySlot
     {
         Chunk* TargetChunk;
+        uint32_t ChunkIndex;
         uint32_t LocalIndex;
         uint32_t GlobalIndex; // Index across all chunks
     };
 
-    EntitySlot PushEntity();
+    // Append a row owned by Id
+    EntitySlot PushEntity(EntityID Id);
+
+    // Append Count uninitialized rows in one go, returns the global index of the first one
+    // Caller is responsible for writing the entity ID column for every new row
+    uint32_t PushEntities(uint32_t Count);
+
+    // Resolve a global row index to chunk/local index (global rows count from the ring head, see HeadRow)
+    EntitySlot GetSlot(uint32_t GlobalIndex)
+    {
+        EntitySlot Slot;
+        Slot.ChunkIndex = (GlobalIndex + HeadRow) / EntitiesPerChunk;
+        Slot.LocalIndex = (GlobalIndex + HeadRow) % EntitiesPerChunk;
+        Slot.GlobalIndex = GlobalIndex;
+        Slot.TargetChunk = Chunks[Slot.ChunkIndex];
+        return Slot;
+    }
+
+    // Remove an entity with swap-and-pop, the tail row is moved into the hole
+    // Returns the ID of the entity that was moved (Invalid if the removed row was the tail)
+    // Empty tail chunks are released immediately
+    EntityID RemoveEntity(uint32_t ChunkIndex, uint32_t LocalIndex);
+
+    // Release every row and chunk (layout is kept)
+    void Clear();
+
+    // --- Concurrent append (any thread, between sync points) ---
+    // Rows are staged in pending chunks that iteration doesn't see until CommitPendingRows.
+    // Reservation and pending chunk installs are CAS loops, a failed reservation takes no rows.
+    static constexpr uint32_t MAX_PENDING_CHUNKS = 256;
+
+    // Reserve Count pending rows, returns the first one (UINT32_MAX if staging is full)
+    uint32_t ReservePendingRows(uint32_t Count);
+
+    // Slot of a reserved pending row, allocating its pending chunk on first touch
+    // ChunkIndex is the index into the pending directory until the row is committed
+    EntitySlot GetPendingSlot(uint32_t PendingRow);
+
+    uint32_t GetPendingCount() const
+    {
+        return PendingRowCursor.load(std::memory_order_acquire);
+    }
+
+    // Sync point only: fold pending rows into the dense chunk list
+    // Fills the partial tail chunk from the end of the pending rows, then splices the remaining pending
+    // chunks in as-is. Returns the global index of the first committed row, rows up to TotalEntityCount are new.
+    uint32_t CommitPendingRows();
+
+    // Sync point only: append RowCount rows held by detached chunks (rows dense from Staged[0], see StreamingLoader)
+    // Tops up the partial tail chunk with the last staged rows, then takes the staged chunks over as-is, no row is
+    // copied twice. Returns the index Staged[0] landed at, OutMoveCount rows went into the old tail (from row
+    // RowCount - OutMoveCount on), staged chunks left empty by that are released
+    uint32_t SpliceChunks(const std::vector<Chunk*>& Staged, uint32_t RowCount, uint32_t& OutMoveCount);
+
+    // --- Paging (dormant archetypes only, see ChunkPager) ---
+    // A paged-out chunk keeps its index, its Chunks entry is nullptr and PagedChunks maps it to the pager handle
+    std::unordered_map<uint32_t, uint32_t> PagedChunks;
+
+    // Pack a chunk's live rows (ID column, then every field array, no unused capacity) and release the chunk
+    void PageOutChunk(uint32_t ChunkIndex, std::vector<uint8_t>& OutPacked);
+
+    // Allocate a chunk for a paged-out index and unpack PageOutChunk's bytes into it
+    Chunk* PageInChunk(uint32_t ChunkIndex, const std::vector<uint8_t>& Packed);
+
+    // --- Transient ring (entity classes with a TransientLifetime, see Registry::SpawnTransient) ---
+    // Rows are only appended at the tail and expire from the head in spawn order, nothing is ever swapped.
+    // Live rows start HeadRow rows into Chunks[0], chunks the head leaves behind are reused for the tail
+    bool bTransient = false;
+    uint32_t TransientLifetime = 0; // Ticks a row lives
+    uint32_t HeadRow = 0;
+    uint64_t ExpiredRows = 0; // Rows expired so far, also the ring sequence number of the head row
+
+    // Ring sequence one past the last row spawned before a tick boundary
+    struct SpawnMark
+    {
+        uint32_t Tick;
+        uint64_t EndSequence;
+    };
+
+    std::deque<SpawnMark> SpawnMarks;
+
+    // Live rows that were given an EntityID, rows without one hold Invalid in the ID column
+    uint32_t IssuedIdCount = 0;
+
+    // Drop the Count oldest rows by advancing the head
+    void ExpireRows(uint32_t Count);
+
+    // Global row of a transient row from its chunk (records don't track ring chunk indices, the head moves them)
+    uint32_t GetTransientRow(const Chunk* TargetChunk, uint32_t LocalIndex) const
+    {
+        const size_t ChunkIndex = std::find(Chunks.begin(), Chunks.end(), TargetChunk) - Chunks.begin();
+        return static_cast<uint32_t>(ChunkIndex) * EntitiesPerChunk + LocalIndex - HeadRow;
+    }
+
+    // --- Blocked layout (entity classes with bBlockedLayout, see HasBlockedLayout) ---
+    // Field arrays are interleaved in blocks of BLOCK_ROWS rows, a block holds BLOCK_ROWS elements of every field
+    // back to back so one row's fields sit within a few cache lines instead of a field array apart. offsetInChunk is
+    // then where the field's run starts in the first block, GetElementIndex finds a row's element. The ID column
+    // stays a plain array
+    static constexpr uint32_t BLOCK_ROWS = 8;
+    bool bBlocked = false; // Set before BuildLayout, cleared when the components can't be blocked
+    size_t BlockStride = 0; // Bytes per block, 0 for SoA
+
+    // Element index of a row in a field array, counted from the field's offsetInChunk
+    uint32_t GetElementIndex(uint32_t Row, size_t ElementSize) const
+    {
+        if (BlockStride == 0)
+            return Row;
+        return (Row / BLOCK_ROWS) * static_cast<uint32_t>(BlockStride / ElementSize) + Row % BLOCK_ROWS;
+    }
+
+    // A row's element of field array FieldIdx
+    uint8_t* GetElement(Chunk* TargetChunk, size_t FieldIdx, uint32_t Row) const
+    {
+        const FieldArrayTemplate& Field = FieldArrayTemplateCache[FieldIdx];
+        return TargetChunk->Data + Field.offsetInChunk + GetElementIndex(Row, Field.elementSize) * Field.elementSize;
+    }
+
+    // Visit Count rows of one field from FirstRow as contiguous runs, Visit(uint8_t* Elements, uint32_t Rows)
+    // One run in SoA, one per block touched when blocked
+    template <typename Fn>
+    void ForEachFieldRun(Chunk* TargetChunk, size_t FieldIdx, uint32_t FirstRow, uint32_t Count, Fn&& Visit) const
+    {
+        while (Count > 0)
+        {
+            const uint32_t Run = BlockStride ? std::min(Count, BLOCK_ROWS - FirstRow % BLOCK_ROWS) : Count;
+            Visit(GetElement(TargetChunk, FieldIdx, FirstRow), Run);
+            FirstRow += Run;
+            Count -= Run;
+        }
+    }
+
+    // Rows one kernel call starting at LocalIndex may cover out of Available
+    // Kernels step whole blocks, so a blocked call starting mid-block stops at the block's end
+    uint32_t GetKernelSliceCount(uint32_t LocalIndex, uint32_t Available) const
+    {
+        if (BlockStride == 0 || LocalIndex % BLOCK_ROWS == 0)
+            return Available;
+        return std::min(Available, BLOCK_ROWS - LocalIndex % BLOCK_ROWS);
+    }
+
+    // Count word for a kernel call over Rows rows (see PackKernelCount)
+    uint32_t GetKernelCount(uint32_t Rows) const { return PackKernelCount(Rows, BlockStride); }
 
-    // Remove an entity (swap-and-pop, deferred via active mask)
-    void RemoveEntity(size_t ChunkIndex, uint32_t LocalIndex);
+    // --- Change tracking (see Registry::CreateIndex) ---
+    // Registry's change version, stamped into the header of every chunk whose rows may have been written
+    const uint32_t* ChangeVersionSource = nullptr;
+
+    // Note a possible write to a chunk's rows (fields, IDs or row count), any thread
+    void MarkChanged(Chunk* TargetChunk) const
+    {
+        if (ChangeVersionSource)
+        {
+            std::atomic_ref<uint32_t>(TargetChunk->GetHeader().ChangeVersion).store(
+                *ChangeVersionSource, std::memory_order_relaxed);
+        }
+    }
+
+    // Per-row entity ID column, sits right after the chunk header
+    EntityID* GetEntityIDs(Chunk* TargetChunk)
+    {
+        return reinterpret_cast<EntityID*>(TargetChunk->GetBuffer(Chunk::HEADER_SIZE));
+    }
+
+    // Swap two rows of this archetype (every field array + entity ID)
+    void SwapRows(uint32_t RowA, uint32_t RowB);
+
+    // Merged archetypes only: rows were added or removed since the last SortClassRuns
+    bool NeedsClassSort() const { return bClassRunsDirty; }
+
+    // Group rows into one run per class (ascending ClassID) and rebuild ClassRuns
+    // Counts classes from the ID column, then swaps only the rows that sit outside their class's run.
+    // Every row that moved is appended to OutMovedRows so the caller can fix up its record
+    void SortClassRuns(std::vector<uint32_t>& OutMovedRows);
+
+    // Drop every row flagged in DoomedMasks (one byte per 8-row batch, bit i = row i of the batch, batches restart
+    // at each chunk) by left-packing the survivors column by column, their order is kept. Not for transient rings.
+    // Emptied tail chunks are released. Returns the first row that moved, rows from there to TotalEntityCount
+    // need their records rewritten
+    uint32_t CompactRows(const uint8_t* DoomedMasks);
+
+    // Copy one row to another row of this archetype (every field array + entity ID)
+    void CopyRow(Chunk* SrcChunk, uint32_t SrcIndex, Chunk* DstChunk, uint32_t DstIndex);
+
+    // Copy the fields two archetypes have in common from one row to another
+    // Fields only in Dst get Dst's template row value (zero without one)
+    static void CopyRowBetween(Archetype& Src, Chunk* SrcChunk, uint32_t SrcIndex,
+                               Archetype& Dst, Chunk* DstChunk, uint32_t DstIndex);
 
     // Get typed array pointer for a component in a specific chunk
     template <typename T>
@@ -143,14 +360,36 @@ public:
     struct FieldArrayTemplate
     {
         size_t offsetInChunk;
+        size_t elementSize; // Bytes per row
         const char* debugName; // For debugging
     };
 
     std::vector<FieldArrayTemplate> FieldArrayTemplateCache;
 
+    // TEMPLATE ROW - the class's default field values (see PrefabDefaults), one fill pattern per field array
+    // Each pattern is the element repeated across 32 bytes so a whole AVX register can be stored at once.
+    // All zero when the class declares no defaults, new rows never see bytes a previous row left in the chunk
+    struct alignas(32) FieldFillPattern
+    {
+        uint8_t Bytes[32];
+    };
+
+    std::vector<FieldFillPattern> TemplateRow;
+
+    // Build TemplateRow from a class's defaults, call after BuildLayout()
+    void BuildTemplateRow(const std::vector<FieldDefault>& Defaults);
+
+    bool HasTemplateRow() const { return !TemplateRow.empty(); }
+
+    // Stamp the template row into Count rows starting at LocalIndex of one chunk, one fill per field array
+    void StampTemplateRows(Chunk* TargetChunk, uint32_t LocalIndex, uint32_t Count);
+
+    // Same for a range of global rows, which may span chunks
+    void StampTemplateRows(uint32_t FirstRow, uint32_t Count);
+
     size_t TotalChunkDataSize = 0;
 
-    // Get pointer to a specific field array within a chunk
+    // Get pointer to a specific field array within a chunk (its first block's run when blocked, see GetElementIndex)
     void* GetFieldArray(Chunk* chunk, ComponentTypeID typeID, uint32_t fieldIndex)
     {
         FieldKey key{typeID, fieldIndex};
@@ -161,8 +400,9 @@ public:
     }
 
     // Build field array table using pre-computed template
+    // FirstRow offsets every array so a kernel can start mid-chunk (class runs of merged archetypes)
     // TODO: Just return the offsets Once, that way we can do the math instead of rebuilding the array per chunk
-    void BuildFieldArrayTable(Chunk* chunk, void** outFieldArrayTable)
+    void BuildFieldArrayTable(Chunk* chunk, void** outFieldArrayTable, uint32_t FirstRow = 0)
     {
         auto chunkBase = chunk->Data;
 
@@ -170,7 +410,9 @@ public:
 #pragma loop(ivdep)
         for (size_t i = 0; i < size; ++i)
         {
-            outFieldArrayTable[i] = chunkBase + FieldArrayTemplateCache[i].offsetInChunk;
+            const size_t elementSize = FieldArrayTemplateCache[i].elementSize;
+            outFieldArrayTable[i] = chunkBase + FieldArrayTemplateCache[i].offsetInChunk +
+                GetElementIndex(FirstRow, elementSize) * elementSize;
         }
     }
 
@@ -194,6 +436,17 @@ public:
         }
     }
 
+    // Index of a component's first field array in the field array table, -1 if it isn't stored here
+    int32_t GetFieldTableIndex(ComponentTypeID TypeID) const
+    {
+        for (size_t i = 0; i < CachedFieldArrayLayout.size(); ++i)
+        {
+            if (CachedFieldArrayLayout[i].componentID == TypeID)
+                return static_cast<int32_t>(i);
+        }
+        return -1;
+    }
+
     // Get total field array count (for allocating table)
     size_t GetFieldArrayCount() const
     {
@@ -243,6 +496,27 @@ public:
 private:
     // Allocate a new chunk
     Chunk* AllocateChunk();
+
+    // Blocked variant of BuildLayout, false if the components can't be blocked (BuildLayout then falls back to SoA)
+    bool BuildBlockedLayout(const std::vector<ComponentMetaEx>& Components);
+
+    // Free pending chunks and reset the pending cursor
+    void ReleasePendingChunks();
+
+    // Chunks the ring head has passed, handed out again by AllocateChunk
+    std::vector<Chunk*> RingSpares;
+
+    // Set whenever rows of a merged archetype are added or removed
+    bool bClassRunsDirty = false;
+
+    // Concurrent append staging
+    std::atomic<uint32_t> PendingRowCursor{0};
+    std::unique_ptr<std::atomic<Chunk*>[]> PendingChunks;
+
+    // Chunk fragmentation tracking for the profiler (see AllocateChunk)
+    void* DebugFirstChunk = nullptr;
+    void* DebugLastChunk = nullptr;
+    uint32_t DebugChunkCount = 0;
 };
 
 struct ArchetypeKeyHash
@@ -259,6 +533,10 @@ struct ArchetypeKeyHash
         hash = FNV_OFFSET;
         hash ^= key.ID;
         hash *= FNV_PRIME;
+        hash ^= key.SharedSet;
+        hash *= FNV_PRIME;
+        hash ^= key.Dormant;
+        hash *= FNV_PRIME;
 
         // Process signature in 64-bit chunks
         const uint64_t* data = reinterpret_cast<const uint64_t*>(&key.Sig);
@@ -0,0 +1,150 @@
+#pragma once
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+#include "Types.h"
+
+struct Chunk;
+
+/**
+ * BehaviorFramePool: size-class free lists for coroutine frames
+ *
+ * Frames are rounded up to a cache line and carved out of 64KB chunks from ChunkAllocator, a freed
+ * frame goes back to its class's free list and is reused by the next behavior of about the same size.
+ * Frames over MAX_FRAME_SIZE fall back to the heap. Chunks are kept for the process lifetime.
+ * Thread-safe, behaviors may be created anywhere.
+ */
+class BehaviorFramePool
+{
+public:
+    static constexpr size_t GRANULARITY = 64;
+    static constexpr size_t MAX_FRAME_SIZE = 4096;
+
+    static BehaviorFramePool& Get()
+    {
+        static BehaviorFramePool Instance;
+        return Instance;
+    }
+
+    void* Allocate(size_t Size);
+    void Free(void* Frame, size_t Size);
+
+    uint32_t GetLiveFrameCount() const;
+
+private:
+    BehaviorFramePool() = default;
+    BehaviorFramePool(const BehaviorFramePool&) = delete;
+    BehaviorFramePool& operator=(const BehaviorFramePool&) = delete;
+
+    static constexpr size_t CLASS_COUNT = MAX_FRAME_SIZE / GRANULARITY;
+
+    struct FreeFrame
+    {
+        FreeFrame* Next;
+    };
+
+    mutable std::mutex Mutex;
+    FreeFrame* FreeLists[CLASS_COUNT] = {};
+    std::vector<Chunk*> Chunks;
+    size_t CarveOffset = 0; // Into Chunks.back()
+    uint32_t LiveFrames = 0;
+};
+
+class Registry;
+
+/**
+ * Behavior: C++20 coroutine bound to an entity, for long-running logic (patrols, cooldown sequences...)
+ * that would otherwise be a state machine polled every tick
+ *
+ * A behavior suspends on co_await WaitTicks{N} or co_await WaitEvent{ID} and costs nothing until it's due,
+ * Registry resumes it on the logic thread at the end of the fixed step it's due in (see ScheduleTimer).
+ * It is destroyed when it returns, when StopBehavior is called or when its entity is destroyed.
+ *
+ *   Behavior Patrol(Registry& Reg, EntityID Self)
+ *   {
+ *       for (;;)
+ *       {
+ *           *Reg.GetField<Velocity<>>(Self, 0) *= -1.0f;
+ *           co_await WaitTicks{120};
+ *       }
+ *   }
+ *   Reg.StartBehavior(Id, Patrol(Reg, Id));
+ *
+ * Structural changes go through the command buffer like in any kernel.
+ */
+class Behavior
+{
+public:
+    struct promise_type
+    {
+        Registry* Reg = nullptr; // Set by Registry::StartBehavior
+        uint32_t Slot = 0;
+
+        Behavior get_return_object() { return Behavior(std::coroutine_handle<promise_type>::from_promise(*this)); }
+
+        // Nothing runs until StartBehavior binds the coroutine to its entity
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+
+        static void* operator new(size_t Size) { return BehaviorFramePool::Get().Allocate(Size); }
+        static void operator delete(void* Frame, size_t Size) { BehaviorFramePool::Get().Free(Frame, Size); }
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Behavior(Behavior&& Other) noexcept : Coroutine(Other.Coroutine) { Other.Coroutine = nullptr; }
+    Behavior(const Behavior&) = delete;
+    Behavior& operator=(const Behavior&) = delete;
+    ~Behavior()
+    {
+        if (Coroutine)
+            Coroutine.destroy();
+    }
+
+    // Hand the frame over to its owner
+    Handle Release()
+    {
+        Handle Released = Coroutine;
+        Coroutine = nullptr;
+        return Released;
+    }
+
+private:
+    explicit Behavior(Handle InCoroutine) : Coroutine(InCoroutine) {}
+
+    Handle Coroutine;
+};
+
+// Returned by Registry::StartBehavior, stays unique after the behavior ended
+struct BehaviorHandle
+{
+    uint32_t Slot = 0;
+    uint32_t Generation = 0; // 0 = invalid
+
+    bool IsValid() const { return Generation != 0; }
+};
+
+// co_await WaitTicks{N}: resume once N more fixed steps have ended, the one in progress counts
+struct WaitTicks
+{
+    uint32_t Ticks;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(Behavior::Handle Coroutine) const;
+    void await_resume() const noexcept {}
+};
+
+// co_await WaitEvent{ID}: resume at the end of the fixed step in which Registry::SignalEvent(ID) is called
+struct WaitEvent
+{
+    uint32_t EventID;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(Behavior::Handle Coroutine) const;
+    void await_resume() const noexcept {}
+};
@@ -3,9 +3,19 @@
 
 class Archetype; // Forward declaration (changed from struct to class)
 
+// Per-chunk metadata, lives in the reserved space at the start of every chunk
+struct ChunkHeader
+{
+    uint32_t NumaNode = 0; // Node the chunk's pages are bound to (see ChunkAllocator)
+    uint32_t SharedSet = 0; // Shared component values of every row in the chunk (see SharedComponentStore)
+    uint32_t LastTouched = 0; // Dormant chunks only: Registry paging clock (seconds) of the last use, see ChunkPager
+    uint32_t ChangeVersion = 0; // Registry change version of the last possible write to a row, see Archetype::MarkChanged
+};
+
 struct Chunk
 {
     static constexpr size_t DATA_SIZE = CHUNK_SIZE;
+    static constexpr size_t HEADER_SIZE = 64; // Reserved at the front of Data, field arrays start after it
 
     alignas(64) uint8_t Data[DATA_SIZE]; // 64-byte alignment for cache line optimization
 
@@ -13,4 +23,16 @@ struct Chunk
     {
         return Data + Offset;
     }
+
+    inline ChunkHeader& GetHeader()
+    {
+        return *reinterpret_cast<ChunkHeader*>(Data);
+    }
+
+    inline const ChunkHeader& GetHeader() const
+    {
+        return *reinterpret_cast<const ChunkHeader*>(Data);
+    }
 };
+
+static_assert(sizeof(ChunkHeader) <= Chunk::HEADER_SIZE, "ChunkHeader must fit in the reserved chunk header space");
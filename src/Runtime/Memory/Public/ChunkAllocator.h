@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Chunk.h"
+
+struct EngineConfig;
+enum class NumaChunkPolicy : uint8_t;
+
+/**
+ * ChunkAllocator: NUMA-aware page allocator + pool for archetype chunks
+ *
+ * Chunks are allocated straight from the OS page allocator (64KB, page aligned) and bound
+ * to a NUMA node according to the configured NumaChunkPolicy. The owning node is written
+ * into the chunk header so dispatch code can route chunk work to workers on the same node.
+ *
+ * Freed chunks are kept in per-node free lists and reused before asking the OS for more.
+ * On single-node machines every chunk lands on node 0 and the policy is a no-op.
+ */
+class ChunkAllocator
+{
+public:
+    static ChunkAllocator& Get()
+    {
+        static ChunkAllocator Instance;
+        return Instance;
+    }
+
+    // Apply placement policy from config (call before the first Registry is created)
+    void Initialize(const EngineConfig* Config);
+
+    // Release all pooled chunks back to the OS
+    void Shutdown();
+
+    // Pick the node a new chunk should live on
+    // PlacementSeed: stable per-archetype value (used by the Partition policy)
+    // ChunkIndex: index of the chunk within its archetype (used by the Interleave policy)
+    uint32_t SelectNode(uint32_t PlacementSeed, uint32_t ChunkIndex) const;
+
+    // Allocate a chunk bound to Node, header initialized
+    Chunk* Allocate(uint32_t Node);
+
+    // Return a chunk to its node's free list
+    void Free(Chunk* TargetChunk);
+
+    // Topology queries
+    uint32_t GetNodeCount() const { return NodeCount; }
+    uint32_t GetCurrentNode() const; // Node of the CPU the calling thread is running on
+    bool PinCurrentThreadToNode(uint32_t Node) const;
+
+private:
+    ChunkAllocator();
+    ~ChunkAllocator();
+    ChunkAllocator(const ChunkAllocator&) = delete;
+    ChunkAllocator& operator=(const ChunkAllocator&) = delete;
+
+    // OS page allocation, bound to Node when the machine has more than one
+    static Chunk* AllocatePages(uint32_t Node, bool bBindToNode);
+    static void FreePages(Chunk* TargetChunk);
+
+    struct NodePool
+    {
+        std::mutex Mutex;
+        std::vector<Chunk*> FreeChunks;
+    };
+
+    std::unique_ptr<NodePool[]> Pools;
+    uint32_t NodeCount = 1;
+    NumaChunkPolicy Policy;
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * ChunkPager: page file for chunks of dormant archetypes that have been idle for a while
+ *
+ * Registry packs a chunk's live rows (see Archetype::PageOutChunk), hands the bytes here and returns the
+ * chunk to the pool right away. Archetype::PageInChunk unpacks them into a fresh chunk on access. Pages are compressed on the calling thread and written to the page file
+ * by a background writer, so the sync point never waits on the disk. Reading a page that hasn't been
+ * written yet is served from the write queue. File space of pages that were read back is reused.
+ *
+ * Compression only elides zero runs (zeroed fields and unset defaults are the bulk of idle data),
+ * everything else is stored as-is. Thread-safe.
+ */
+class ChunkPager
+{
+public:
+    ChunkPager() = default;
+    ~ChunkPager();
+
+    ChunkPager(const ChunkPager&) = delete;
+    ChunkPager& operator=(const ChunkPager&) = delete;
+
+    // Create the page file (truncated) and start the writer, false if the file can't be opened
+    bool Open(const std::string& InPath);
+
+    bool IsOpen() const { return Writer.joinable(); }
+
+    // Queue a page for writing, returns the handle to read it back with
+    uint32_t Write(const std::vector<uint8_t>& Page);
+
+    // Read a page back into Out and release its handle
+    bool Read(uint32_t Handle, std::vector<uint8_t>& Out);
+
+    // Drop every page, the file is kept for reuse
+    void Reset();
+
+    // Pages currently held and their size in the file
+    uint32_t GetPageCount() const;
+    uint64_t GetCompressedBytes() const;
+
+private:
+    struct PageSlot
+    {
+        uint64_t Offset = 0; // File range reserved for the page
+        uint32_t Capacity = 0;
+        uint32_t Size = 0; // Compressed size
+        uint32_t RawSize = 0;
+        std::vector<uint8_t> Queued; // Compressed bytes not handed to the writer yet
+        bool bLive = false;
+    };
+
+    // Zero-run encoding, repeated [uint16 zero count][uint16 literal count][literal bytes]
+    static void Compress(const std::vector<uint8_t>& Raw, std::vector<uint8_t>& Out);
+    static bool Decompress(const uint8_t* Data, size_t Size, std::vector<uint8_t>& Out, size_t RawSize);
+
+    // File range for a page of Size bytes, reusing released ranges first (Mutex held)
+    void ReserveRange(PageSlot& Slot, uint32_t Size);
+
+    void WriterMain();
+
+    std::string Path;
+    std::fstream File;
+    std::thread Writer;
+
+    mutable std::mutex Mutex; // Slots, queue and free ranges
+    std::mutex FileMutex; // File position, taken after Mutex when both are needed
+    std::condition_variable QueueCondition;
+    bool bStopWriter = false;
+
+    std::vector<PageSlot> Slots;
+    std::vector<uint32_t> FreeHandles;
+    std::deque<uint32_t> WriteQueue;
+    std::vector<std::pair<uint64_t, uint32_t>> FreeRanges; // Offset, capacity
+    uint64_t FileEnd = 0;
+    uint32_t LiveCount = 0;
+    uint64_t LiveBytes = 0;
+};
@@ -0,0 +1,238 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "EntityIndexTable.h"
+#include "JobSystem.h"
+#include "Types.h"
+
+enum class EntityCommandType : uint8_t
+{
+    Create,
+    Destroy,
+    AddComponent,
+    RemoveComponent,
+    SetShared,
+    Activate,
+    Deactivate
+};
+
+// One recorded structural change
+struct EntityCommand
+{
+    uint64_t SortKey; // (Phase << 32) | JobIndex, identical no matter which worker ran the job
+    uint32_t Sequence; // Recording order within the buffer
+    EntityCommandType Type;
+    uint32_t Payload; // ClassID for Create, ComponentTypeID for Add/RemoveComponent, value handle for SetShared
+    EntityID Target;
+
+    bool operator<(const EntityCommand& Other) const
+    {
+        return SortKey != Other.SortKey ? SortKey < Other.SortKey : Sequence < Other.Sequence;
+    }
+};
+
+/**
+ * PendingIDTable: placeholder IDs for deferred creates
+ *
+ * A recorded Create gets a pending ID right away: generation 0 (no live record has it, so lookups reject it),
+ * a ticket in the index bits, the class in the type bits and the sync point's parity in the owner bits.
+ * Real IDs are allocated at playback in sorted command order, recycled indices first, so they only depend
+ * on the recorded commands and not on which worker recorded them. Tickets restart every sync point.
+ */
+class PendingIDTable
+{
+public:
+    static constexpr uint32_t MAX_TICKETS = EntityIndexTable::MAX_INDEX;
+
+    static bool IsPending(EntityID Id) { return Id.IsValid() && Id.GetGeneration() == 0; }
+
+    // Reserve Count tickets for the next sync point, returns the first one (0 when they are used up), any thread
+    uint32_t Reserve(uint32_t Count)
+    {
+        uint32_t First = NextTicket.load(std::memory_order_relaxed);
+        do
+        {
+            if (Count > MAX_TICKETS - First)
+                return 0;
+        }
+        while (!NextTicket.compare_exchange_weak(First, First + Count, std::memory_order_relaxed));
+        return First;
+    }
+
+    EntityID MakePending(uint32_t Ticket, ClassID ID) const
+    {
+        EntityID Id;
+        Id.Value = 0;
+        Id.Index = Ticket;
+        Id.TypeID = ID;
+        Id.OwnerID = Epoch & 1;
+        return Id;
+    }
+
+    // Start playing back the commands recorded so far, tickets reserved from here on belong to the next sync point
+    void BeginPlayback()
+    {
+        Resolved.assign(NextTicket.load(std::memory_order_relaxed), Mapping{});
+        NextTicket.store(1, std::memory_order_relaxed);
+        ++Epoch;
+    }
+
+    void Assign(EntityID Pending, EntityID Real)
+    {
+        if (IsPending(Pending) && Pending.GetIndex() < Resolved.size())
+        {
+            Resolved[Pending.GetIndex()] = {Pending, Real};
+        }
+    }
+
+    // Real ID of a pending ID played back by the last sync point (Invalid if it wasn't), other IDs as they are
+    EntityID Resolve(EntityID Id) const
+    {
+        if (!IsPending(Id))
+            return Id;
+        if (Id.GetIndex() >= Resolved.size() || Resolved[Id.GetIndex()].Pending != Id)
+            return EntityID::Invalid();
+        return Resolved[Id.GetIndex()].Real;
+    }
+
+    // Forget every ticket (not thread-safe)
+    void Reset()
+    {
+        Resolved.clear();
+        NextTicket.store(1, std::memory_order_relaxed);
+    }
+
+private:
+    struct Mapping
+    {
+        EntityID Pending = EntityID::Invalid();
+        EntityID Real = EntityID::Invalid();
+    };
+
+    std::atomic<uint32_t> NextTicket{1}; // 0 would make the placeholder Invalid
+    std::vector<Mapping> Resolved;
+    uint32_t Epoch = 0;
+};
+
+/**
+ * EntityCommandBuffer: Deferred structural changes recorded during a phase
+ *
+ * Every Registry owns one buffer per JobSystem worker slot, so recording never locks.
+ * Commands are stamped with the registry phase and the job index that recorded them, which
+ * depend only on the chunk layout and not on which thread ran the job. At the sync point the
+ * Registry merges all buffers, sorts by (phase, job, sequence) and plays them back in bulk.
+ * Creates get a pending ID up front (see PendingIDTable) from a per-buffer range of tickets, later commands
+ * may target it and playback swaps in the real ID.
+ */
+class alignas(64) EntityCommandBuffer
+{
+public:
+    static constexpr uint32_t TICKET_RESERVE_BATCH = 64;
+
+    // Phase counter is owned by the Registry, it bumps it around every parallel dispatch
+    // Tickets for pending IDs are reserved from the Registry's table in batches
+    void SetSources(const uint32_t* InPhase, PendingIDTable* InPendingIds)
+    {
+        Phase = InPhase;
+        PendingIds = InPendingIds;
+    }
+
+    // Returns a pending ID that later commands (AddComponent, Destroy...) can target straight away.
+    // Registry::ResolveCreated turns it into the entity's real ID once the sync point played it back
+    template <typename T>
+    EntityID Create()
+    {
+        EntityID Id = ReservePendingID(T::StaticClassID());
+        Record(EntityCommandType::Create, Id, T::StaticClassID());
+        return Id;
+    }
+
+    // Create without an ID, for transient classes whose rows are never referenced (see Registry::SpawnTransient)
+    // Other classes still get one at playback
+    template <typename T>
+    void Spawn()
+    {
+        Record(EntityCommandType::Create, EntityID::Invalid(), T::StaticClassID());
+    }
+
+    void Destroy(EntityID Id)
+    {
+        Record(EntityCommandType::Destroy, Id, 0);
+    }
+
+    template <typename C>
+    void AddComponent(EntityID Id)
+    {
+        Record(EntityCommandType::AddComponent, Id, GetComponentTypeID<C>());
+    }
+
+    template <typename C>
+    void RemoveComponent(EntityID Id)
+    {
+        Record(EntityCommandType::RemoveComponent, Id, GetComponentTypeID<C>());
+    }
+
+    void Activate(EntityID Id)
+    {
+        Record(EntityCommandType::Activate, Id, 0);
+    }
+
+    void Deactivate(EntityID Id)
+    {
+        Record(EntityCommandType::Deactivate, Id, 0);
+    }
+
+    void Record(EntityCommandType Type, EntityID Id, uint32_t Payload)
+    {
+        const uint64_t PhaseKey = Phase ? *Phase : 0;
+        Commands.push_back({
+            (PhaseKey << 32) | JobSystem::GetCurrentJobIndex(),
+            NextSequence++,
+            Type,
+            Payload,
+            Id
+        });
+    }
+
+    bool IsEmpty() const { return Commands.empty(); }
+    const std::vector<EntityCommand>& GetCommands() const { return Commands; }
+
+    void Clear()
+    {
+        Commands.clear();
+        NextSequence = 0;
+    }
+
+    // Drop the reserved-but-unused ticket range too, tickets restart every sync point
+    void Reset()
+    {
+        Clear();
+        ReservedNext = ReservedEnd = 0;
+    }
+
+private:
+    EntityID ReservePendingID(ClassID ID)
+    {
+        if (ReservedNext == ReservedEnd && PendingIds)
+        {
+            ReservedNext = PendingIds->Reserve(TICKET_RESERVE_BATCH);
+            ReservedEnd = ReservedNext ? ReservedNext + TICKET_RESERVE_BATCH : 0;
+        }
+
+        // Out of tickets, the entity is still created but can't be referenced before the sync point
+        if (ReservedNext == ReservedEnd)
+            return EntityID::Invalid();
+
+        return PendingIds->MakePending(ReservedNext++, ID);
+    }
+
+    PendingIDTable* PendingIds = nullptr;
+    uint32_t ReservedNext = 0;
+    uint32_t ReservedEnd = 0;
+
+    std::vector<EntityCommand> Commands;
+    const uint32_t* Phase = nullptr;
+    uint32_t NextSequence = 0;
+};
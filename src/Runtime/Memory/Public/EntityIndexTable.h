@@ -0,0 +1,114 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#include "EntityRecord.h"
+
+// Paged entity lookup table (indexed by EntityID.GetIndex())
+// Pages are allocated on first touch and never move, so records can be read and written from any
+// thread while other threads grow the table. Fresh indices are handed out lock-free.
+class EntityIndexTable
+{
+public:
+    static constexpr uint32_t PAGE_SHIFT = 12;
+    static constexpr uint32_t PAGE_SIZE = 1u << PAGE_SHIFT;
+    static constexpr uint32_t MAX_INDEX = 1u << EntityIDLayout::INDEX_BITS; // Matches the width of EntityID::Index
+    static constexpr uint32_t MAX_PAGES = MAX_INDEX / PAGE_SIZE;
+    static_assert(MAX_INDEX % PAGE_SIZE == 0, "EntityID::Index must cover at least one page");
+
+    EntityIndexTable()
+    {
+        for (std::atomic<EntityRecord*>& Page : Pages)
+        {
+            Page.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~EntityIndexTable()
+    {
+        for (std::atomic<EntityRecord*>& Page : Pages)
+        {
+            delete[] Page.load(std::memory_order_relaxed);
+        }
+    }
+
+    EntityIndexTable(const EntityIndexTable&) = delete;
+    EntityIndexTable& operator=(const EntityIndexTable&) = delete;
+
+    // Record for an index whose page is known to exist
+    EntityRecord& operator[](uint32_t Index)
+    {
+        return Pages[Index >> PAGE_SHIFT].load(std::memory_order_acquire)[Index & (PAGE_SIZE - 1)];
+    }
+
+    // Record for Index, nullptr if it was never written
+    EntityRecord* Find(uint32_t Index)
+    {
+        if (Index >= MAX_INDEX)
+            return nullptr;
+
+        EntityRecord* Page = Pages[Index >> PAGE_SHIFT].load(std::memory_order_acquire);
+        return Page ? &Page[Index & (PAGE_SIZE - 1)] : nullptr;
+    }
+
+    // Record for Index, allocating its page if needed (lock-free, safe from any thread)
+    EntityRecord& Ensure(uint32_t Index)
+    {
+        std::atomic<EntityRecord*>& Slot = Pages[Index >> PAGE_SHIFT];
+        EntityRecord* Page = Slot.load(std::memory_order_acquire);
+        if (!Page)
+        {
+            EntityRecord* NewPage = new EntityRecord[PAGE_SIZE]();
+            if (Slot.compare_exchange_strong(Page, NewPage, std::memory_order_acq_rel))
+            {
+                Page = NewPage;
+            }
+            else
+            {
+                // Another thread got there first, Page now holds its pointer
+                delete[] NewPage;
+            }
+        }
+        return Page[Index & (PAGE_SIZE - 1)];
+    }
+
+    // Reserve Count never-used indices, returns the first one (0 when the index space is exhausted).
+    // A failed reservation takes nothing, NextIndex never moves past MAX_INDEX
+    uint32_t ReserveRange(uint32_t Count)
+    {
+        uint32_t First = NextIndex.load(std::memory_order_relaxed);
+        do
+        {
+            if (Count > MAX_INDEX - First)
+                return 0;
+        }
+        while (!NextIndex.compare_exchange_weak(First, First + Count, std::memory_order_relaxed));
+        return First;
+    }
+
+    // Hand back the range of the last ReserveRange call, a no-op once a later reservation followed it
+    // (those indices then stay unused, no record was written for them)
+    void ReleaseRange(uint32_t First, uint32_t Count)
+    {
+        uint32_t Expected = First + Count;
+        NextIndex.compare_exchange_strong(Expected, First, std::memory_order_relaxed);
+    }
+
+    // Invalidate every record and start handing out indices from 1 again (not thread-safe)
+    void Reset()
+    {
+        for (std::atomic<EntityRecord*>& Slot : Pages)
+        {
+            if (EntityRecord* Page = Slot.load(std::memory_order_relaxed))
+            {
+                std::fill(Page, Page + PAGE_SIZE, EntityRecord{});
+            }
+        }
+        NextIndex.store(1, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<EntityRecord*> Pages[MAX_PAGES];
+    std::atomic<uint32_t> NextIndex{1}; // 0 is reserved for Invalid
+};
@@ -1,6 +1,8 @@
 #pragma once
 #include <cstdint>
 
+#include "Types.h"
+
 // Forward declarations
 class Archetype; // Changed from struct to class
 struct Chunk;
@@ -11,12 +13,19 @@ struct EntityRecord
 {
     Archetype* Arch = nullptr; // Which archetype this entity belongs to
     Chunk* TargetChunk = nullptr; // Which chunk within that archetype
-    uint16_t Index = 0; // Index within the chunk
-    uint16_t Generation = 0; // For validation (matches EntityID.Generation)
+    uint32_t ChunkIndex = 0; // Position of TargetChunk in Arch->Chunks (not kept up to date in transient rings)
+    ChunkRow Index = 0; // Index within the chunk
+    EntityGeneration Generation = 0; // For validation (matches EntityID.Generation)
 
     // Check if this record is valid
     bool IsValid() const
     {
         return Arch != nullptr && TargetChunk != nullptr;
     }
+
+    // Live, but its chunk was paged out (Arch->PagedChunks[ChunkIndex]), Registry::FindRecord pages it back in
+    bool IsPagedOut() const
+    {
+        return Arch != nullptr && TargetChunk == nullptr;
+    }
 };
@@ -1,16 +1,64 @@
 #pragma once
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
 #include <queue>
+#include <shared_mutex>
+#include <span>
+#include <string>
 #include <unordered_map>
 #include <vector>
 #include "Archetype.h"
+#include "Behavior.h"
+#include "ChunkPager.h"
+#include "EntityCommandBuffer.h"
+#include "EntityIndexTable.h"
 #include "EntityRecord.h"
 #include "FieldMeta.h"
+#include "JobSystem.h"
 #include "Schema.h"
+#include "SharedComponentStore.h"
+#include "SparseSet.h"
 #include "Signature.h"
 #include "TemporalComponentCache.h"
+#include "TimerWheel.h"
+#include "ValueIndex.h"
 #include "Types.h"
 
 struct EngineConfig;
+class Registry;
+
+// One caller-owned SoA column for GatherFields/ScatterFields
+// Data holds one element of field FieldIndex per requested ID, in request order
+struct FieldColumn
+{
+    uint32_t FieldIndex;
+    void* Data;
+};
+
+// One fired timer as seen by its callback, the entity's row is resolved and its chunk resident
+struct TimerFire
+{
+    EntityID Id;
+    uint64_t Payload;
+    Chunk* TargetChunk;
+    uint32_t LocalIndex;
+};
+
+// One value index hit, resolved to its row (chunk resident)
+struct IndexHit
+{
+    EntityID Id;
+    Chunk* TargetChunk;
+    uint32_t LocalIndex;
+};
+
+// Timer callbacks get the fires of one archetype at a time, rows in chunk order
+using TimerCallback = void (*)(Registry* Reg, Archetype* Arch, const TimerFire* Fires, uint32_t Count);
+
 // Registry - Central entity management system
 // Handles entity creation, destruction, and component access
 class Registry
@@ -25,34 +73,223 @@ public:
     template <typename T>
     EntityID Create();
 
-    // Destroy an entity (deferred until end of frame)
+    // Create Count entities of T on the logic thread, rows are reserved and stamped with the class defaults
+    // in one go, then OnCreate runs batched over all of them. Returns how many were created
+    template <typename T>
+    uint32_t CreateBatch(uint32_t Count, EntityID* OutIds);
+
+    // Thread-safe creation from any thread (workers, network...), lock-free apart from the sync point fence
+    // The ID and its components are usable right away, the entity joins iteration at the next sync point
+    template <typename T>
+    EntityID CreateConcurrent();
+
+    // Bulk version, one atomic reservation for IDs and one for rows. Returns how many were created
+    template <typename T>
+    uint32_t CreateConcurrent(uint32_t Count, EntityID* OutIds);
+
+    // Spawn Count rows of a transient class (static constexpr uint32_t TransientLifetime = N;) on the logic thread.
+    // Rows go to the class's ring and expire N fixed ticks later (see InvokePostPhys) by advancing the ring head,
+    // OnDestroy runs batched over them first. Rows only get an EntityID when OutIds is passed, IDs can be used
+    // with GetField/Destroy, a destroyed row is filled with the ring's oldest row. Returns how many were spawned.
+    // Kernels spawn through GetCommandBuffer().Spawn<T>(). Other classes get regular rows with IDs
+    template <typename T>
+    uint32_t SpawnTransient(uint32_t Count, EntityID* OutIds = nullptr);
+
+    // Destroy an entity (deferred until the next sync point, safe to call from parallel kernels)
+    // OnDestroy runs batched over the doomed rows at the sync point, before any of them are removed.
+    // Hooks must record structural changes through the command buffer, they play back at the next sync point
     void Destroy(EntityID Id);
 
-    // Get component from entity
+    // Add/remove a component on an existing entity (deferred like Destroy, added components start zeroed)
+    // Components from the entity's schema can't be removed, the class kernels depend on them
+    template <typename C>
+    void AddComponent(EntityID Id);
+    template <typename C>
+    void RemoveComponent(EntityID Id);
+
+    // --- Region streaming (see StreamingLoader) ---
+    // Write the schema components of Ids to a region file, grouped by class. Logic thread only
+    bool SaveRegion(std::span<const EntityID> Ids, const std::string& Path);
+
+    // Decode a region file image into detached staging chunks with their records built, any thread.
+    // Rows get fresh IDs and are spliced into their archetypes chunk by chunk at the next sync point,
+    // where OnCreate runs over them. Returns how many entities were staged
+    uint32_t StageRegion(const uint8_t* Data, size_t Size);
+
+    // --- Timers (see TimerWheel) ---
+    // Callbacks are registered once and referenced by ID from ScheduleTimer
+    uint32_t RegisterTimerCallback(TimerCallback Callback);
+
+    // Call Callback for Id once DelayTicks more fixed steps have ended (the one in progress counts), any thread.
+    // Due timers fire at the end of InvokePostPhys after the sync point, batched per callback and archetype.
+    // Timers of destroyed entities are dropped. Callbacks record structural changes through the command buffer
+    TimerHandle ScheduleTimer(EntityID Id, uint32_t DelayTicks, uint32_t CallbackID, uint64_t Payload = 0);
+
+    // False if the timer already fired or was cancelled
+    bool CancelTimer(TimerHandle Handle);
+
+    // --- Behaviors (see Behavior) ---
+    // Bind a behavior to Id and run it up to its first co_await, logic thread only. Behaviors are resumed
+    // through the timer wheel, so only due ones cost anything. Returns an invalid handle if Id is stale
+    BehaviorHandle StartBehavior(EntityID Id, Behavior&& Body);
+
+    // Destroy a behavior where it's suspended, false if it already ended
+    bool StopBehavior(BehaviorHandle Handle);
+
+    // Wake every behavior waiting on EventID, logic thread only
+    void SignalEvent(uint32_t EventID);
+
+    uint32_t GetBehaviorCount() const { return LiveBehaviors; }
+
+    // Put an entity to sleep / wake it up (deferred like Destroy). Dormant entities keep their data and ID
+    // but live in separate chunks that lifecycle phases, ForEach queries and rendering never visit.
+    // OnDeactivate/OnActivate hooks run batched over the moved rows at the sync point.
+    // Transient entities can't change archetype (Activate, Add/RemoveComponent, SetShared are ignored)
+    void Deactivate(EntityID Id) { GetCommandBuffer().Deactivate(Id); }
+    void Activate(EntityID Id) { GetCommandBuffer().Activate(Id); }
+
+    // False for dormant and stale IDs
+    bool IsActive(EntityID Id);
+
+    // Give an entity a shared component value (deferred like AddComponent, adds S if the entity lacks it)
+    // Entities are grouped into chunks by their shared values, RemoveComponent<S> drops the value again
+    template <typename S>
+    void SetShared(EntityID Id, const S& Value);
+
+    // Shared value of an entity, or of every row in a chunk / archetype (nullptr if it has none)
+    template <typename S>
+    const S* GetShared(EntityID Id);
+    template <typename S>
+    const S* GetShared(const Chunk* TargetChunk) const;
+    template <typename S>
+    const S* GetShared(const Archetype* Arch) const;
+
+    // Sparse-set components (STRIGID_REGISTER_SPARSE_COMPONENT), attached without changing archetype
+    // Immediate, logic thread only. AddSparse returns the existing value if there is one, new values start zeroed
+    template <typename S>
+    S* AddSparse(EntityID Id);
+    template <typename S>
+    S* GetSparse(EntityID Id);
+    template <typename S>
+    bool RemoveSparse(EntityID Id);
+
+    // Structural command buffer for the calling thread's slot (see JobSystem::GetWorkerSlot). Every thread records
+    // into its own buffer, so any thread may record (Destroy, Activate, AddComponent, SetShared...) without locking,
+    // as long as it doesn't overlap FlushCommandBuffers
+    EntityCommandBuffer& GetCommandBuffer() { return CommandBuffers[JobSystem::GetWorkerSlot()]; }
+
+    // Real ID of an entity created through GetCommandBuffer().Create, valid from the sync point that played the
+    // create back until the next one (Invalid before it). IDs that aren't pending are returned as they are
+    EntityID ResolveCreated(EntityID Id) const { return PendingIds.Resolve(Id); }
+
+    // Sync point: merge every worker's command buffer and play them back in deterministic order
+    // Called automatically at the end of each Invoke* phase
+    void FlushCommandBuffers();
+
+    // Get component from entity (non-decomposed components only, SoA components have no per-entity struct)
     template <typename T>
     T* GetComponent(EntityID Id);
 
+    // Address of one entity's element in a field array of a decomposed component, nullptr if stale or missing
+    // Usage: float* X = Reg.GetField<Transform<>>(Id, FieldIndexOf<Transform<>>("PositionX"));
+    template <typename C, typename F = float>
+    F* GetField(EntityID Id, uint32_t FieldIndex);
+
     // Check if entity has component
     template <typename T>
     bool HasComponent(EntityID Id);
 
-    // Get or create archetype for a given signature
-    Archetype* GetOrCreateArchetype(const Signature& Sig, const ClassID& ID);
+    // Batched random access for ID lists (network apply, damage resolution, targeting...)
+    // Copies the requested fields of C between the entities' rows and caller SoA columns. Generations are
+    // validated 8 IDs at a time, rows are visited grouped by chunk with prefetching. Stale IDs and entities
+    // without C are skipped and get 0 in OutValid (optional, one byte per ID). Returns how many IDs resolved
+    template <typename C>
+    uint32_t GatherFields(std::span<const EntityID> Ids, std::span<const FieldColumn> Columns, uint8_t* OutValid = nullptr);
+    template <typename C>
+    uint32_t ScatterFields(std::span<const EntityID> Ids, std::span<const FieldColumn> Columns, uint8_t* OutValid = nullptr);
+
+    // Get or create archetype for a given signature (and shared value set, see SharedComponentStore)
+    Archetype* GetOrCreateArchetype(const Signature& Sig, const ClassID& ID, uint32_t SharedSet = 0,
+                                    bool bDormant = false);
 
     // Apply all pending destructions (called at end of frame)
-    void ProcessDeferredDestructions();
+    void ProcessDeferredDestructions() { FlushCommandBuffers(); }
 
     template <typename... Components>
     std::vector<Archetype*> ComponentQuery();
 
+    // Run a system over every entity that has all of Components, across all archetypes, 8 rows at a time
+    // Body gets one bound view per component, unmasked for full batches and masked (Transform<true>...)
+    // for each chunk's tail, so write it as a generic lambda:
+    //   Reg.ForEach<Transform, ColorData>([dt](auto& T, auto& C) { T.RotationZ += dt; C.A *= 0.99f; });
+    // Structural changes recorded from Body apply at the next sync point
+    template <template <bool> class... Components, typename Fn>
+    void ForEach(Fn&& Body);
+
+    // ForEach with one job per chunk on the JobSystem, Body must be safe to run concurrently
+    template <template <bool> class... Components, typename Fn>
+    void ParallelForEach(Fn&& Body);
+
+    // ForEach over entities with shared component S, Body(const S& Value, auto&... Views)
+    // The value is looked up once per archetype and archetypes are visited grouped by value
+    // (e.g. one draw batch per mesh/material)
+    template <typename S, template <bool> class... Components, typename Fn>
+    void ForEachShared(Fn&& Body);
+
+    // Join a sparse-set component with archetype components: Body(S& Value, auto&... Views) once per entity
+    // that has S and all of Components. Walks the (small) sparse set in chunk order, so the field array table
+    // is rebuilt once per chunk. Views are masked to the entity's single row
+    template <typename S, template <bool> class... Components, typename Fn>
+    void ForEachSparse(Fn&& Body);
+
+    // Destroy, right away, every entity with all of Components whose lane Predicate flags (sync point only)
+    // Predicate gets views like a ForEach body and returns the batch's lane mask (bit i = destroy row i),
+    // typically a compare over whole registers read with Load():
+    //   Reg.DestroyWhere<Transform>([](auto& T)
+    //   {
+    //       return _mm256_movemask_ps(_mm256_cmp_ps(T.PositionY.Load(), _mm256_set1_ps(-100.0f), _CMP_LT_OQ));
+    //   });
+    // OnDestroy runs first, then each archetype's survivors are left-packed in place, field array by field array,
+    // and only the records of rows that moved are rewritten. Dormant entities aren't visited. Returns the count destroyed
+    template <template <bool> class... Components, typename Fn>
+    uint32_t DestroyWhere(Fn&& Predicate);
+
+    // Deterministic fingerprint of the simulated state, for desync detection and checking that parallel or SIMD
+    // changes leave results bit-identical. Hashes each chunk's row IDs and hot component fields in parallel, then
+    // folds the chunk hashes in archetype/chunk order, so the value doesn't depend on the worker count. Dormant
+    // archetypes are skipped, their chunks page out on wall-clock timers. IDs and rows of entities made with
+    // CreateConcurrent depend on thread timing, create through the command buffer when the checksum must match
+    uint64_t ComputeStateChecksum();
+
+    // --- Value indexes (see ValueIndex) ---
+    // Index field FieldIndex of C (stored as F) across every archetype with C, logic thread only.
+    // Built right away, then kept up to date by UpdateIndexes from the chunks written since the last step
+    // (change versions in the chunk headers, diffed row by row against a copy of the indexed column).
+    // Transient classes aren't indexed. Returns the index ID, UINT32_MAX if C has no such field
+    template <typename C, typename F = float>
+    uint32_t CreateIndex(uint32_t FieldIndex, ValueIndexKind Kind = ValueIndexKind::Ordered);
+
+    // Fold changed chunks into every index, runs at the end of InvokePostPhys. Call it first when a
+    // query must see writes made since then
+    void UpdateIndexes();
+
+    // Entities with Min <= value <= Max (ordered indexes) or value == Value, as of the last UpdateIndexes.
+    // Appended in key order, entities destroyed since are skipped. Return how many were appended.
+    // The IndexHit versions are grouped by chunk, rows ascending, for batch processing
+    uint32_t QueryIndexRange(uint32_t IndexID, double Min, double Max, std::vector<EntityID>& OutIds);
+    uint32_t QueryIndexRange(uint32_t IndexID, double Min, double Max, std::vector<IndexHit>& OutHits);
+    uint32_t QueryIndexEqual(uint32_t IndexID, double Value, std::vector<EntityID>& OutIds);
+    uint32_t QueryIndexEqual(uint32_t IndexID, double Value, std::vector<IndexHit>& OutHits);
+
     // Invoke all lifecycle functions of a specific type
     void InvokeUpdate(double dt = 0.0);
     void InvokePrePhys(double dt = 0.0);
     void InvokePostPhys(double dt = 0.0);
 
-    // Memory diagnostics
+    // Memory diagnostics (paged-out chunks are included in the chunk count)
     uint32_t GetTotalChunkCount() const;
     uint32_t GetTotalEntityCount() const;
+    uint32_t GetPagedChunkCount() const { return Pager.GetPageCount(); }
 
     // Resets the registry to default, useful after tests.
     // TODO: this needs to not be public.
@@ -62,23 +299,261 @@ private:
     // Initialize archetypes with data from MetaRegistry
     void InitializeArchetypes();
 
-    // Global entity lookup table (indexed by EntityID.GetIndex())
-    std::vector<EntityRecord> EntityIndex;
+    // New archetype with its layout and its class's template row built
+    Archetype* CreateArchetype(const Archetype::ArchetypeKey& Key);
+
+    // Point classes with identical storage at one shared archetype (EngineConfig::bMergeSameSignatureClasses)
+    void MergeClassArchetypes();
+
+    // Re-sort merged archetypes whose rows changed into class runs, called before each phase dispatch
+    void SortClassRuns();
+
+    // Calls Visit(ChunkIndex, FirstRow, Count, Kernel) for every kernel invocation of a phase in Arch, Count being the
+    // kernel count word (see Archetype::GetKernelCount):
+    // one per chunk, or one per chunk slice of each class run in a merged archetype
+    template <typename Fn>
+    void ForEachPhaseRange(Archetype* Arch, UpdateFunc EntityMeta::* Phase, Fn&& Visit);
+
+    // Component list for an archetype: class schema components first (hydration order), extras after
+    std::vector<ComponentMetaEx> BuildComponentList(const Signature& Sig, ClassID ID);
+
+    // Append a row for a freshly allocated ID
+    EntityID CreateInArchetype(Archetype* Arch, ClassID ID);
+
+    // Point the index entry for Id at a row
+    void WriteRecord(EntityID Id, Archetype* Arch, const Archetype::EntitySlot& Slot);
+
+    // Swap-and-pop the record's row and fix up the record of the entity moved into the hole
+    void RemoveRow(const EntityRecord& Record);
+
+    // Move an entity to the archetype with TypeID added/removed
+    void MigrateEntity(EntityID Id, ComponentTypeID TypeID, bool bAdd);
+
+    // Move an entity to the archetype for its shared set with ValueHandle applied
+    void ApplySharedValue(EntityID Id, uint32_t ValueHandle);
+
+    // Move a row to another archetype, carrying over the fields both have
+    void MoveToArchetype(EntityID Id, EntityRecord& Record, Archetype* Dst);
+
+    // Command playback, each handles a run of same-typed commands
+    void PlaybackCreates(const EntityCommand* Begin, const EntityCommand* End);
+    void PlaybackDestroys(const EntityCommand* Begin, const EntityCommand* End);
+    void PlaybackActivations(const EntityCommand* Begin, const EntityCommand* End, bool bActivate);
+
+    // DestroyWhere for one archetype, DoomedMasks as filled by InvokePredicateImpl (one byte per batch of each chunk)
+    uint32_t DestroyFlaggedRows(Archetype* Arch, const std::vector<uint8_t>& DoomedMasks);
+
+    // Active <-> dormant counterpart of an archetype
+    Archetype* GetTwin(Archetype* Arch);
+
+    // Run a batched hook kernel (OnCreate, OnActivate, ...) over rows [FirstRow, FirstRow + Count), one call per chunk slice
+    void InvokeRowHook(Archetype* Arch, UpdateFunc Hook, uint32_t FirstRow, uint32_t Count);
+
+    // Validate Id against the index, nullptr if stale
+    // A paged-out row is paged back in unless bPageIn is false, the record is then returned with a null TargetChunk
+    EntityRecord* FindRecord(EntityID Id, bool bPageIn = true);
+
+    // Shared implementation of GatherFields/ScatterFields
+    uint32_t CopyFieldsBatch(ComponentTypeID TypeID, std::span<const EntityID> Ids, std::span<const FieldColumn> Columns,
+                             uint8_t* OutValid, bool bScatter);
 
-    // Free list for recycled entity indices
+    // Global entity lookup table (indexed by EntityID.GetIndex()), paged so it can grow concurrently
+    EntityIndexTable EntityIndex;
+
+    // Free list for recycled entity indices (sync point / logic thread only)
     std::queue<uint32_t> FreeIndices;
 
-    // Next entity index to allocate (if free list is empty)
-    uint32_t NextEntityIndex = 0;
+    // Shared by CreateConcurrent callers, exclusive while the sync point commits and plays back
+    std::shared_mutex ConcurrentAppendMutex;
+
+    // Fold rows staged by CreateConcurrent into their archetypes
+    void CommitConcurrentCreates();
 
     // Archetype storage (pair<signature, classID> → archetype)
     std::unordered_map<Archetype::ArchetypeKey, Archetype*, ArchetypeKeyHash> Archetypes;
 
-    // Pending destructions (processed at end of frame)
-    std::vector<EntityID> PendingDestructions;
+    // ClassID -> Archetype lookup for Create<T>, owned per Registry so worlds never share storage
+    // Sized to MAX_ENTITY_CLASSES and filled for every registered class on construction
+    std::vector<Archetype*> ClassArchetypeCache;
+
+    // Archetypes shared by several classes, and scratch for the records their sorting moves
+    std::vector<Archetype*> MergedArchetypes;
+    std::vector<uint32_t> ClassSortMovedRows;
+
+    // Interned shared component values, referenced by archetype keys and chunk headers
+    SharedComponentStore SharedValues;
+
+    // Sparse-set storage indexed by ComponentTypeID, created on first use
+    std::vector<std::unique_ptr<SparseSet>> SparseSets;
+    SparseSet* GetSparseSet(ComponentTypeID TypeID, bool bCreate);
+
+    // One command buffer per JobSystem worker slot (see EntityCommandBuffer)
+    std::unique_ptr<EntityCommandBuffer[]> CommandBuffers;
+    PendingIDTable PendingIds;
+    uint32_t CommandPhase = 0;
+    std::vector<EntityCommand> PlaybackScratch;
 
     TemporalComponentCache HistorySlab;
 
+    // --- Paging of idle dormant chunks (EngineConfig::DormantChunkPageOutSeconds) ---
+    // Page out dormant chunks idle past the threshold, called at the start of every sync point
+    void PageOutIdleChunks();
+
+    // Bring a paged-out chunk back and point its rows' records at it, safe from any thread
+    void PageIn(Archetype* Arch, uint32_t ChunkIndex);
+
+    // Rows are pushed to and popped from the last chunk, it has to be resident first
+    void EnsureTailResident(Archetype* Arch);
+
+    // --- Transient rings ---
+    // Mark the rows spawned this tick and expire the ones whose lifetime is up, called at the end of InvokePostPhys
+    void ExpireTransients();
+
+    // Fill destroyed transient rows (ring sequence numbers, ascending) from the ring head, then advance it
+    void RemoveTransientRows(Archetype* Arch, std::vector<uint64_t>& Sequences);
+
+    std::vector<Archetype*> TransientArchetypes;
+    uint32_t TransientTick = 0;
+
+    // --- Timers ---
+    // Advance the wheel one tick and dispatch what's due, called at the end of InvokePostPhys
+    void FireTimers();
+
+    std::mutex TimerMutex; // Timers only, never held while callbacks run
+    TimerWheel Timers;
+    std::vector<TimerCallback> TimerCallbacks;
+    std::vector<TimerExpiry> TimerScratch;
+
+    // --- Value indexes ---
+    // Reads row Row of a field column as an index key
+    using IndexKeyLoader = double (*)(const uint8_t* Column, uint32_t Row);
+
+    template <typename F>
+    static double LoadIndexKey(const uint8_t* Column, uint32_t Row)
+    {
+        F Value;
+        std::memcpy(&Value, Column + Row * sizeof(F), sizeof(F));
+        return static_cast<double>(Value);
+    }
+
+    // One archetype feeding an index, Shadow holds each chunk's rows as of the last step
+    // (Invalid Id where the row didn't exist or its key was NaN)
+    struct IndexSource
+    {
+        Archetype* Arch;
+        size_t ColumnOffset;
+        std::vector<std::vector<ValueIndex::Entry>> Shadow;
+    };
+
+    struct FieldIndexState
+    {
+        ComponentTypeID TypeID;
+        uint32_t FieldIndex;
+        uint32_t ElementSize;
+        IndexKeyLoader LoadKey;
+        ValueIndex Index;
+        std::vector<IndexSource> Sources;
+        size_t KnownArchetypes = 0; // Archetypes.size() when Sources were collected
+        uint32_t SyncedVersion = 0;
+    };
+
+    uint32_t CreateIndex(ComponentTypeID TypeID, uint32_t FieldIndex, uint32_t ElementSize, IndexKeyLoader LoadKey,
+                         ValueIndexKind Kind);
+
+    // Pick up archetypes created since the last step
+    void CollectIndexSources(FieldIndexState& State);
+
+    // Diff one chunk against its shadow into the pending batches
+    void DiffIndexedChunk(const FieldIndexState& State, IndexSource& Source, uint32_t ChunkIndex);
+
+    // Shared implementation of the QueryIndex* overloads
+    template <typename Fn>
+    void VisitIndex(uint32_t IndexID, double Min, double Max, bool bRange, Fn&& Visit);
+
+    std::vector<std::unique_ptr<FieldIndexState>> FieldIndexes;
+    std::vector<ValueIndex::Entry> IndexRemoved;
+    std::vector<ValueIndex::Entry> IndexAdded;
+
+    // Stamped into chunk headers by Archetype::MarkChanged, bumped by every UpdateIndexes
+    uint32_t ChangeVersion = 1;
+
+    // --- Behaviors ---
+    friend struct WaitTicks;
+    friend struct WaitEvent;
+
+    struct BehaviorSlot
+    {
+        Behavior::Handle Coroutine;
+        EntityID Owner;
+        uint32_t Generation = 1;
+        uint32_t NextFree = UINT32_MAX;
+        bool bRunning = false;
+        bool bStopRequested = false; // Stopped while running, destroyed once it suspends
+    };
+
+    // Resume a behavior after Ticks / once EventID is signalled, called from its awaiters
+    void WakeBehavior(uint32_t Slot, uint32_t Ticks);
+    void ParkBehavior(uint32_t Slot, uint32_t EventID);
+
+    // Timer callback of every behavior wake-up, payloads are slot | generation << 32
+    static void ResumeBehaviors(Registry* Reg, Archetype* Arch, const TimerFire* Fires, uint32_t Count);
+    void RunBehavior(uint32_t Slot);
+    void DestroyBehavior(uint32_t Slot);
+
+    // Destroy every behavior bound to Id, called when its ID is freed
+    void ReapBehaviors(EntityID Id);
+
+    std::vector<BehaviorSlot> BehaviorSlots;
+    uint32_t FreeBehaviorSlot = UINT32_MAX;
+    uint32_t LiveBehaviors = 0;
+    uint32_t BehaviorCallbackID = 0;
+    std::unordered_map<uint32_t, std::vector<uint64_t>> EventWaiters; // Payloads as for ResumeBehaviors
+    std::vector<uint64_t> SignalScratch;
+    std::unordered_multimap<uint32_t, uint32_t> BehaviorOwners; // Entity index -> slot
+
+    // Rows staged by StageRegion for one class, Chunks hold them dense from row 0
+    // Row r has entity index FirstIndex + r, its record points at its staging chunk (ChunkIndex relative to Chunks)
+    struct StagedRun
+    {
+        Archetype* Arch;
+        ClassID ID;
+        std::vector<Chunk*> Chunks;
+        uint32_t RowCount;
+        uint32_t FirstIndex;
+    };
+
+    // Splice every staged run into its archetype, called at the start of every sync point
+    void SpliceStagedRuns();
+    void ReleaseStagedRuns();
+
+    std::mutex StagingMutex;
+    std::vector<StagedRun> StagedRuns;
+
+    ChunkPager Pager;
+    std::mutex PagingMutex;
+    uint32_t PageOutSeconds = 0; // 0 = paging off
+    uint32_t PagingClock = 0; // Seconds since construction, updated each sync point
+    std::chrono::steady_clock::time_point PagingEpoch = std::chrono::steady_clock::now();
+
+    // Per-chunk job list for parallel phase dispatch (reused every tick)
+    struct ChunkJob
+    {
+        Archetype* Arch;
+        uint32_t ChunkIndex;
+        uint32_t FirstRow;
+        uint32_t Count;
+        UpdateFunc Func;
+    };
+
+    std::vector<ChunkJob> PhaseJobs;
+    std::vector<uint8_t> PhaseJobNodes;
+
+    // Archetypes holding all of Components, with where each component's fields start in its field array table
+    // Extra: additional required signature bits (tags/shared components not passed as views)
+    template <template <bool> class... Components>
+    void GatherForEachTargets(std::vector<Archetype*>& OutArchs, std::vector<int32_t>& OutTableIndices,
+                              const Signature& Extra = Signature());
+
     // Allocate a new EntityID
     EntityID AllocateEntityID(uint16_t TypeID);
 
@@ -95,13 +570,11 @@ private:
 template <typename T>
 EntityID Registry::Create()
 {
-    // Static local caching - archetype is calculated once per type T
-    static Archetype* CachedArchetype = nullptr;
-    static bool Initialized = false;
-
-    if (!Initialized)
+    // Per-registry caching - archetype is looked up once per type T per Registry
+    const ClassID classID = T::StaticClassID();
+    Archetype* CachedArchetype = ClassArchetypeCache[classID];
+    if (!CachedArchetype)
     {
-        ClassID classID = T::StaticClassID();
         MetaRegistry& MR = MetaRegistry::Get();
 
 #ifdef _DEBUG // || _WITH_EDITOR
@@ -126,50 +599,202 @@ EntityID Registry::Create()
         Signature Sig = MR.ClassToArchetype[classID];
 
         CachedArchetype = GetOrCreateArchetype(Sig, classID);
-        Initialized = true;
+        ClassArchetypeCache[classID] = CachedArchetype;
     }
 
+    return CreateInArchetype(CachedArchetype, classID);
+}
+
+inline EntityID Registry::CreateInArchetype(Archetype* Arch, ClassID ID)
+{
     // Allocate entity ID
-    EntityID Id = AllocateEntityID(T::StaticClassID());
+    EntityID Id = AllocateEntityID(ID);
 
     // Allocate slot in archetype
-    Archetype::EntitySlot Slot = CachedArchetype->PushEntity();
+    Archetype::EntitySlot Slot = Arch->PushEntity(Id);
+    Arch->StampTemplateRows(Slot.TargetChunk, Slot.LocalIndex, 1);
 
-    // Update EntityIndex
-    uint32_t Index = Id.GetIndex();
-    if (Index >= EntityIndex.size())
+    WriteRecord(Id, Arch, Slot);
+    Arch->IssuedIdCount += Arch->bTransient;
+    if (UpdateFunc OnCreate = MetaRegistry::Get().EntityGetters[ID].OnCreate)
     {
-        EntityIndex.resize(Index * 2);
+        InvokeRowHook(Arch, OnCreate, Arch->TotalEntityCount - 1, 1);
     }
+    return Id;
+}
 
-    EntityRecord& Record = EntityIndex[Index];
-    Record.Arch = CachedArchetype;
+inline void Registry::WriteRecord(EntityID Id, Archetype* Arch, const Archetype::EntitySlot& Slot)
+{
+    // Update EntityIndex
+    EntityRecord& Record = EntityIndex.Ensure(Id.GetIndex());
+    Record.Arch = Arch;
     Record.TargetChunk = Slot.TargetChunk;
-    Record.Index = static_cast<uint16_t>(Slot.LocalIndex);
+    Record.ChunkIndex = Slot.ChunkIndex;
+    Record.Index = static_cast<ChunkRow>(Slot.LocalIndex);
     Record.Generation = Id.GetGeneration();
+}
 
-    return Id;
+template <typename T>
+uint32_t Registry::CreateBatch(uint32_t Count, EntityID* OutIds)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    const ClassID classID = T::StaticClassID();
+    Archetype* Arch = ClassArchetypeCache[classID];
+    if (!Arch || Count == 0)
+        return 0;
+
+    const uint32_t FirstRow = Arch->PushEntities(Count);
+    for (uint32_t i = 0; i < Count; ++i)
+    {
+        EntityID Id = AllocateEntityID(classID);
+        Archetype::EntitySlot Slot = Arch->GetSlot(FirstRow + i);
+        Arch->GetEntityIDs(Slot.TargetChunk)[Slot.LocalIndex] = Id;
+        WriteRecord(Id, Arch, Slot);
+        OutIds[i] = Id;
+    }
+    Arch->IssuedIdCount += Arch->bTransient ? Count : 0;
+    Arch->StampTemplateRows(FirstRow, Count);
+
+    if (UpdateFunc OnCreate = MetaRegistry::Get().EntityGetters[classID].OnCreate)
+    {
+        InvokeRowHook(Arch, OnCreate, FirstRow, Count);
+    }
+    return Count;
 }
 
 template <typename T>
-T* Registry::GetComponent(EntityID Id)
+uint32_t Registry::SpawnTransient(uint32_t Count, EntityID* OutIds)
 {
-    if (!Id.IsValid())
-        return nullptr;
+    STRIGID_ZONE_C(STRIGID_COLOR_MEMORY);
+    const ClassID classID = T::StaticClassID();
+    Archetype* Arch = ClassArchetypeCache[classID];
+    if (!Arch || Count == 0)
+        return 0;
+
+    // Rows of regular archetypes are always referenced by their record
+    const bool bIssueIds = OutIds || !Arch->bTransient;
+    const uint32_t FirstRow = Arch->PushEntities(Count);
+    for (uint32_t i = 0; i < Count; ++i)
+    {
+        Archetype::EntitySlot Slot = Arch->GetSlot(FirstRow + i);
+        const EntityID Id = bIssueIds ? AllocateEntityID(classID) : EntityID::Invalid();
+        Arch->GetEntityIDs(Slot.TargetChunk)[Slot.LocalIndex] = Id;
+        if (bIssueIds)
+        {
+            WriteRecord(Id, Arch, Slot);
+        }
+        if (OutIds)
+        {
+            OutIds[i] = Id;
+        }
+    }
+    Arch->IssuedIdCount += (Arch->bTransient && bIssueIds) ? Count : 0;
+    Arch->StampTemplateRows(FirstRow, Count);
 
-    uint32_t Index = Id.GetIndex();
-    if (Index >= EntityIndex.size())
-        return nullptr;
+    if (UpdateFunc OnCreate = MetaRegistry::Get().EntityGetters[classID].OnCreate)
+    {
+        InvokeRowHook(Arch, OnCreate, FirstRow, Count);
+    }
+    return Count;
+}
 
-    EntityRecord& Record = EntityIndex[Index];
+template <typename T>
+EntityID Registry::CreateConcurrent()
+{
+    EntityID Id;
+    return CreateConcurrent<T>(1, &Id) ? Id : EntityID::Invalid();
+}
 
-    // Validate generation (detect use-after-free)
-    if (Record.Generation != Id.GetGeneration())
-        return nullptr;
+template <typename T>
+uint32_t Registry::CreateConcurrent(uint32_t Count, EntityID* OutIds)
+{
+    const ClassID classID = T::StaticClassID();
+    Archetype* Arch = ClassArchetypeCache[classID];
+    if (!Arch || Count == 0)
+        return 0;
 
-    if (!Record.IsValid())
+    if (Arch->bTransient)
+    {
+        LOG_ERROR_F("CreateConcurrent: class %u is transient, spawn it through the command buffer", classID);
+        return 0;
+    }
+
+    std::shared_lock<std::shared_mutex> AppendLock(ConcurrentAppendMutex);
+
+    // Neither reservation takes anything when it fails, the indices are handed back if the rows don't fit
+    const uint32_t FirstIndex = EntityIndex.ReserveRange(Count);
+    if (FirstIndex == 0)
+    {
+        LOG_ERROR("CreateConcurrent: out of entity indices");
+        return 0;
+    }
+    const uint32_t FirstRow = Arch->ReservePendingRows(Count);
+    if (FirstRow == UINT32_MAX)
+    {
+        EntityIndex.ReleaseRange(FirstIndex, Count);
+        LOG_ERROR("CreateConcurrent: out of pending rows");
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < Count; ++i)
+    {
+        EntityID Id;
+        Id.Value = 0;
+        Id.Index = FirstIndex + i;
+        Id.Generation = 1; // Fresh indices always start at generation 1
+        Id.TypeID = classID;
+
+        Archetype::EntitySlot Slot = Arch->GetPendingSlot(FirstRow + i);
+        Arch->GetEntityIDs(Slot.TargetChunk)[Slot.LocalIndex] = Id;
+        WriteRecord(Id, Arch, Slot);
+        OutIds[i] = Id;
+    }
+
+    // Stamp defaults and run OnCreate one pending chunk run at a time, on the calling thread
+    const UpdateFunc OnCreate = MetaRegistry::Get().EntityGetters[classID].OnCreate;
+    for (uint32_t Row = FirstRow, EndRow = FirstRow + Count; (Arch->HasTemplateRow() || OnCreate) && Row < EndRow;)
+    {
+        Archetype::EntitySlot Slot = Arch->GetPendingSlot(Row);
+        const uint32_t Run = Arch->GetKernelSliceCount(Slot.LocalIndex,
+                                                       std::min(EndRow - Row, Arch->EntitiesPerChunk - Slot.LocalIndex));
+        Arch->StampTemplateRows(Slot.TargetChunk, Slot.LocalIndex, Run);
+        if (OnCreate)
+        {
+            constexpr size_t MAX_FIELD_ARRAYS = 64; // Max total fields across all components in archetype
+            void* fieldArrayTable[MAX_FIELD_ARRAYS];
+            Arch->BuildFieldArrayTable(Slot.TargetChunk, fieldArrayTable, Slot.LocalIndex);
+            OnCreate(this, 0.0, fieldArrayTable, Arch->GetKernelCount(Run));
+        }
+        Row += Run;
+    }
+
+    return Count;
+}
+
+template <typename C>
+void Registry::AddComponent(EntityID Id)
+{
+    GetCommandBuffer().AddComponent<C>(Id);
+}
+
+template <typename C>
+void Registry::RemoveComponent(EntityID Id)
+{
+    GetCommandBuffer().RemoveComponent<C>(Id);
+}
+
+template <typename T>
+T* Registry::GetComponent(EntityID Id)
+{
+    static_assert(!HasDefineFields<T>, "Field-decomposed components are stored SoA, use GetField or GatherFields");
+
+    // Validates generation (detect use-after-free)
+    EntityRecord* Found = FindRecord(Id);
+    if (!Found)
         return nullptr;
 
+    EntityRecord& Record = *Found;
+
     // TODO: Get ComponentTypeID from reflection (Week 5)
     ComponentTypeID TypeID = GetComponentTypeID<T>();
 
@@ -179,13 +804,49 @@ T* Registry::GetComponent(EntityID Id)
         return nullptr;
 
     // Return pointer to this entity's component
+    Record.Arch->MarkChanged(Record.TargetChunk);
     return &ComponentArray[Record.Index];
 }
 
+template <typename C, typename F>
+F* Registry::GetField(EntityID Id, uint32_t FieldIndex)
+{
+    EntityRecord* Record = FindRecord(Id);
+    if (!Record)
+        return nullptr;
+
+    const int32_t TableIndex = Record->Arch->GetFieldTableIndex(GetComponentTypeID<C>());
+    if (TableIndex < 0 || FieldIndex >= ComponentFieldRegistry::Get().GetFieldCount(GetComponentTypeID<C>()))
+        return nullptr;
+
+    assert(Record->Arch->FieldArrayTemplateCache[TableIndex + FieldIndex].elementSize == sizeof(F));
+    Record->Arch->MarkChanged(Record->TargetChunk);
+    return reinterpret_cast<F*>(Record->Arch->GetElement(Record->TargetChunk, TableIndex + FieldIndex, Record->Index));
+}
+
+template <typename C, typename F>
+uint32_t Registry::CreateIndex(uint32_t FieldIndex, ValueIndexKind Kind)
+{
+    return CreateIndex(GetComponentTypeID<C>(), FieldIndex, sizeof(F), &LoadIndexKey<F>, Kind);
+}
+
 template <typename T>
 bool Registry::HasComponent(EntityID Id)
 {
-    return GetComponent<T>(Id) != nullptr;
+    EntityRecord* Record = FindRecord(Id);
+    return Record && Record->Arch->ArchSignature.Has(GetComponentTypeID<T>() - 1);
+}
+
+template <typename C>
+uint32_t Registry::GatherFields(std::span<const EntityID> Ids, std::span<const FieldColumn> Columns, uint8_t* OutValid)
+{
+    return CopyFieldsBatch(GetComponentTypeID<C>(), Ids, Columns, OutValid, false);
+}
+
+template <typename C>
+uint32_t Registry::ScatterFields(std::span<const EntityID> Ids, std::span<const FieldColumn> Columns, uint8_t* OutValid)
+{
+    return CopyFieldsBatch(GetComponentTypeID<C>(), Ids, Columns, OutValid, true);
 }
 
 template <typename... Components>
@@ -200,112 +861,457 @@ Signature Registry::BuildSignature()
 template <typename... Components>
 std::vector<Archetype*> Registry::ComponentQuery()
 {
-    std::vector<Archetype*> Results(Archetypes.size());
+    std::vector<Archetype*> Results(Archetypes.size() + 1);
     Archetype** ArchPtr = &Results[0];
     bool Valid = false;
     Signature Sig = BuildSignature<Components...>();
     for (auto Arch : Archetypes)
     {
-        Valid = Arch.first.Sig.Contains(Sig);
+        Valid = !Arch.first.Dormant && Arch.first.Sig.Contains(Sig);
         *ArchPtr = Arch.second;
         ArchPtr += !!Valid;
     }
 
+    // Null out the tail so callers can stop at the first nullptr
+    Results.resize(ArchPtr - Results.data() + 1);
+    Results.back() = nullptr;
+
     return Results;
 }
 
-inline void Registry::InvokeUpdate(double dt)
+template <template <bool> class... Components>
+void Registry::GatherForEachTargets(std::vector<Archetype*>& OutArchs, std::vector<int32_t>& OutTableIndices,
+                                    const Signature& Extra)
+{
+    static_assert(((HasDefineFields<Components<false>> || IsTagComponent<Components<false>>) && ...),
+                  "ForEach only supports field-decomposed and tag components");
+
+    Signature Sig = BuildSignature<Components<false>...>();
+    Sig.Bits |= Extra.Bits;
+    for (auto& [key, arch] : Archetypes)
+    {
+        if (arch->TotalEntityCount == 0 || arch->bDormant || !key.Sig.Contains(Sig))
+            continue;
+
+        OutArchs.push_back(arch);
+        // Tags only filter, their views bind to nothing
+        (OutTableIndices.push_back(IsTagComponent<Components<false>>
+                                       ? 0
+                                       : arch->GetFieldTableIndex(GetComponentTypeID<Components<false>>())), ...);
+    }
+}
+
+template <template <bool> class... Components, typename Fn>
+void Registry::ForEach(Fn&& Body)
 {
     STRIGID_ZONE_C(STRIGID_COLOR_LOGIC);
+    constexpr size_t QueryWidth = sizeof...(Components);
+
+    std::vector<Archetype*> Archs;
+    std::vector<int32_t> TableIndices;
+    GatherForEachTargets<Components...>(Archs, TableIndices);
 
     constexpr size_t MAX_FIELD_ARRAYS = 64; // Max total fields across all components in archetype
     void* fieldArrayTable[MAX_FIELD_ARRAYS];
 
-    for (auto& [sig, arch] : Archetypes)
+    for (size_t archIdx = 0; archIdx < Archs.size(); ++archIdx)
     {
-        UpdateFunc Update = MetaRegistry::Get().EntityGetters[sig.ID].Update;
-        if (!Update)
-            continue;
+        Archetype* arch = Archs[archIdx];
+        for (size_t chunkIdx = 0; chunkIdx < arch->Chunks.size(); ++chunkIdx)
+        {
+            arch->MarkChanged(arch->Chunks[chunkIdx]);
+            arch->BuildFieldArrayTable(arch->Chunks[chunkIdx], fieldArrayTable, arch->GetChunkFirstRow(chunkIdx));
+            InvokeForEachImpl<Components...>(Body, fieldArrayTable, TableIndices.data() + archIdx * QueryWidth,
+                                             arch->GetChunkCount(chunkIdx), static_cast<uint32_t>(arch->BlockStride));
+        }
+    }
+}
+
+template <template <bool> class... Components, typename Fn>
+void Registry::ParallelForEach(Fn&& Body)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_LOGIC);
+    constexpr size_t QueryWidth = sizeof...(Components);
+
+    std::vector<Archetype*> Archs;
+    std::vector<int32_t> TableIndices;
+    GatherForEachTargets<Components...>(Archs, TableIndices);
 
-        size_t size = arch->Chunks.size();
-        for (size_t chunkIdx = 0; chunkIdx < size; ++chunkIdx)
+    // Flatten to one job per chunk, routed to the chunk's NUMA node like the lifecycle phases
+    struct QueryChunkJob
+    {
+        Archetype* Arch;
+        uint32_t ChunkIndex;
+        const int32_t* TableIndices;
+    };
+
+    std::vector<QueryChunkJob> Jobs;
+    std::vector<uint8_t> JobNodes;
+    for (size_t archIdx = 0; archIdx < Archs.size(); ++archIdx)
+    {
+        Archetype* arch = Archs[archIdx];
+        for (size_t chunkIdx = 0; chunkIdx < arch->Chunks.size(); ++chunkIdx)
         {
-            Chunk* chunk = arch->Chunks[chunkIdx];
-            uint32_t entityCount = arch->GetChunkCount(chunkIdx);
+            Jobs.push_back({arch, static_cast<uint32_t>(chunkIdx), TableIndices.data() + archIdx * QueryWidth});
+            JobNodes.push_back(static_cast<uint8_t>(arch->Chunks[chunkIdx]->GetHeader().NumaNode));
+        }
+    }
 
-            if (entityCount == 0)
-                continue;
+    // Commands recorded by the jobs get their own phase, same as InvokePrePhys
+    ++CommandPhase;
+    JobSystem::Get().ParallelFor(static_cast<uint32_t>(Jobs.size()), [&](uint32_t JobIndex)
+    {
+        constexpr size_t MAX_FIELD_ARRAYS = 64; // Max total fields across all components in archetype
+        void* fieldArrayTable[MAX_FIELD_ARRAYS];
+
+        const QueryChunkJob& Job = Jobs[JobIndex];
+        Job.Arch->MarkChanged(Job.Arch->Chunks[Job.ChunkIndex]);
+        Job.Arch->BuildFieldArrayTable(Job.Arch->Chunks[Job.ChunkIndex], fieldArrayTable,
+                                       Job.Arch->GetChunkFirstRow(Job.ChunkIndex));
+        InvokeForEachImpl<Components...>(Body, fieldArrayTable, Job.TableIndices,
+                                         Job.Arch->GetChunkCount(Job.ChunkIndex),
+                                         static_cast<uint32_t>(Job.Arch->BlockStride));
+    }, JobNodes.data());
+    ++CommandPhase;
+}
 
-            // Build field array table on stack (fast!)
-            // For CubeEntity (Transform + Velocity): 12 + 4 = 16 entries
-            arch->BuildFieldArrayTable(chunk, fieldArrayTable);
+template <template <bool> class... Components, typename Fn>
+uint32_t Registry::DestroyWhere(Fn&& Predicate)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_LOGIC);
+    constexpr size_t QueryWidth = sizeof...(Components);
 
-            // Invoke batch processor with field array table
-            Update(dt, fieldArrayTable, entityCount);
+    std::vector<Archetype*> Archs;
+    std::vector<int32_t> TableIndices;
+    GatherForEachTargets<Components...>(Archs, TableIndices);
+
+    constexpr size_t MAX_FIELD_ARRAYS = 64; // Max total fields across all components in archetype
+    void* fieldArrayTable[MAX_FIELD_ARRAYS];
+
+    std::vector<uint8_t> DoomedMasks;
+    uint32_t Destroyed = 0;
+    for (size_t archIdx = 0; archIdx < Archs.size(); ++archIdx)
+    {
+        Archetype* arch = Archs[archIdx];
+        const uint32_t BatchesPerChunk = (arch->EntitiesPerChunk + 7) / 8;
+        DoomedMasks.assign(arch->Chunks.size() * BatchesPerChunk, 0);
+        for (size_t chunkIdx = 0; chunkIdx < arch->Chunks.size(); ++chunkIdx)
+        {
+            arch->BuildFieldArrayTable(arch->Chunks[chunkIdx], fieldArrayTable, arch->GetChunkFirstRow(chunkIdx));
+            InvokePredicateImpl<Components...>(Predicate, fieldArrayTable, TableIndices.data() + archIdx * QueryWidth,
+                                               arch->GetChunkCount(chunkIdx),
+                                               DoomedMasks.data() + chunkIdx * BatchesPerChunk,
+                                               static_cast<uint32_t>(arch->BlockStride));
         }
+        Destroyed += DestroyFlaggedRows(arch, DoomedMasks);
     }
+
+    STRIGID_PLOT("Entities Destroyed Where", static_cast<int64_t>(Destroyed));
+    return Destroyed;
 }
 
-inline void Registry::InvokePrePhys(double dt)
+template <typename S, template <bool> class... Components, typename Fn>
+void Registry::ForEachShared(Fn&& Body)
 {
     STRIGID_ZONE_C(STRIGID_COLOR_LOGIC);
+    static_assert(IsSharedComponent<S>, "ForEachShared needs a shared component");
+    constexpr size_t QueryWidth = sizeof...(Components);
+    const ComponentTypeID SharedType = GetComponentTypeID<S>();
+
+    Signature Extra;
+    Extra.Set(SharedType - 1);
+
+    std::vector<Archetype*> Archs;
+    std::vector<int32_t> TableIndices;
+    GatherForEachTargets<Components...>(Archs, TableIndices, Extra);
+
+    // Visit archetypes grouped by value handle, equal values end up next to each other
+    std::vector<std::pair<uint32_t, uint32_t>> Order; // (value handle, slot in Archs)
+    Order.reserve(Archs.size());
+    for (uint32_t archIdx = 0; archIdx < Archs.size(); ++archIdx)
+    {
+        Order.emplace_back(SharedValues.FindHandle(Archs[archIdx]->SharedSet, SharedType), archIdx);
+    }
+    std::sort(Order.begin(), Order.end());
 
     constexpr size_t MAX_FIELD_ARRAYS = 64; // Max total fields across all components in archetype
     void* fieldArrayTable[MAX_FIELD_ARRAYS];
 
-    for (auto& [sig, arch] : Archetypes)
+    for (const auto& [Handle, archIdx] : Order)
     {
-        UpdateFunc prePhys = MetaRegistry::Get().EntityGetters[sig.ID].PrePhys;
-        if (!prePhys)
+        Archetype* arch = Archs[archIdx];
+        const S* Value = GetShared<S>(arch);
+        if (!Value)
             continue;
 
-        size_t size = arch->Chunks.size();
-        for (size_t chunkIdx = 0; chunkIdx < size; ++chunkIdx)
+        auto Bound = [&](auto&... Views) { Body(*Value, Views...); };
+        for (size_t chunkIdx = 0; chunkIdx < arch->Chunks.size(); ++chunkIdx)
         {
-            Chunk* chunk = arch->Chunks[chunkIdx];
-            uint32_t entityCount = arch->GetChunkCount(chunkIdx);
+            arch->MarkChanged(arch->Chunks[chunkIdx]);
+            arch->BuildFieldArrayTable(arch->Chunks[chunkIdx], fieldArrayTable, arch->GetChunkFirstRow(chunkIdx));
+            InvokeForEachImpl<Components...>(Bound, fieldArrayTable, TableIndices.data() + archIdx * QueryWidth,
+                                             arch->GetChunkCount(chunkIdx), static_cast<uint32_t>(arch->BlockStride));
+        }
+    }
+}
 
-            if (entityCount == 0)
-                continue;
+template <typename S>
+S* Registry::AddSparse(EntityID Id)
+{
+    static_assert(IsSparseComponent<S>, "AddSparse needs a component registered with STRIGID_REGISTER_SPARSE_COMPONENT");
+    if (!FindRecord(Id))
+        return nullptr;
+    return static_cast<S*>(GetSparseSet(GetComponentTypeID<S>(), true)->Emplace(Id));
+}
 
-            // Build field array table on stack (fast!)
-            // For CubeEntity (Transform + Velocity): 12 + 4 = 16 entries
-            arch->BuildFieldArrayTable(chunk, fieldArrayTable);
+template <typename S>
+S* Registry::GetSparse(EntityID Id)
+{
+    SparseSet* Set = GetSparseSet(GetComponentTypeID<S>(), false);
+    return Set ? static_cast<S*>(Set->Find(Id)) : nullptr;
+}
 
-            // Invoke batch processor with field array table
-            prePhys(dt, fieldArrayTable, entityCount);
+template <typename S>
+bool Registry::RemoveSparse(EntityID Id)
+{
+    SparseSet* Set = GetSparseSet(GetComponentTypeID<S>(), false);
+    return Set && Set->Remove(Id);
+}
+
+template <typename S, template <bool> class... Components, typename Fn>
+void Registry::ForEachSparse(Fn&& Body)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_LOGIC);
+    static_assert(IsSparseComponent<S>, "ForEachSparse needs a sparse-set component");
+
+    SparseSet* Set = GetSparseSet(GetComponentTypeID<S>(), false);
+    if (!Set || Set->Size() == 0)
+        return;
+
+    const Signature Sig = BuildSignature<Components<false>...>();
+
+    // Resolve every element to its row, then visit in chunk/row order
+    struct SparseRow
+    {
+        Chunk* TargetChunk;
+        Archetype* Arch;
+        uint32_t LocalIndex;
+        uint32_t DenseIndex;
+    };
+
+    std::vector<SparseRow> Rows;
+    Rows.reserve(Set->Size());
+    const EntityID* DenseIds = Set->GetDenseIDs();
+    for (uint32_t i = 0; i < Set->Size(); ++i)
+    {
+        EntityRecord* Record = FindRecord(DenseIds[i], false);
+        if (Record && !Record->Arch->bDormant && Record->Arch->ArchSignature.Contains(Sig))
+        {
+            Rows.push_back({Record->TargetChunk, Record->Arch, Record->Index, i});
+        }
+    }
+    std::sort(Rows.begin(), Rows.end(), [](const SparseRow& A, const SparseRow& B)
+    {
+        return A.TargetChunk != B.TargetChunk ? A.TargetChunk < B.TargetChunk : A.LocalIndex < B.LocalIndex;
+    });
+
+    constexpr size_t MAX_FIELD_ARRAYS = 64; // Max total fields across all components in archetype
+    void* fieldArrayTable[MAX_FIELD_ARRAYS];
+    int32_t TableIndices[sizeof...(Components) + 1] = {};
+    Chunk* BoundChunk = nullptr;
+    Archetype* BoundArch = nullptr;
+
+    for (const SparseRow& Row : Rows)
+    {
+        if (Row.Arch != BoundArch)
+        {
+            BoundArch = Row.Arch;
+            uint32_t i = 0;
+            ((TableIndices[i++] = IsTagComponent<Components<false>>
+                                      ? 0
+                                      : BoundArch->GetFieldTableIndex(GetComponentTypeID<Components<false>>())), ...);
         }
+        if (Row.TargetChunk != BoundChunk)
+        {
+            BoundChunk = Row.TargetChunk;
+            BoundArch->MarkChanged(BoundChunk);
+            BoundArch->BuildFieldArrayTable(BoundChunk, fieldArrayTable);
+        }
+
+        std::tuple<Components<true>...> Views;
+        std::apply([&](auto&... View)
+        {
+            uint32_t i = 0;
+            (View.Bind(&fieldArrayTable[TableIndices[i++]], Row.LocalIndex, 1,
+                       static_cast<uint32_t>(BoundArch->BlockStride)), ...);
+            Body(*static_cast<S*>(Set->GetDenseValue(Row.DenseIndex)), View...);
+        }, Views);
     }
 }
 
-inline void Registry::InvokePostPhys(double dt)
+template <typename S>
+void Registry::SetShared(EntityID Id, const S& Value)
+{
+    static_assert(IsSharedComponent<S>, "SetShared needs a component registered with STRIGID_REGISTER_SHARED_COMPONENT");
+    const uint32_t Handle = SharedValues.InternValue(GetComponentTypeID<S>(), &Value, sizeof(S));
+    GetCommandBuffer().Record(EntityCommandType::SetShared, Id, Handle);
+}
+
+template <typename S>
+const S* Registry::GetShared(EntityID Id)
+{
+    EntityRecord* Record = FindRecord(Id);
+    return Record ? GetShared<S>(Record->Arch) : nullptr;
+}
+
+template <typename S>
+const S* Registry::GetShared(const Chunk* TargetChunk) const
+{
+    return static_cast<const S*>(SharedValues.Find(TargetChunk->GetHeader().SharedSet, GetComponentTypeID<S>()));
+}
+
+template <typename S>
+const S* Registry::GetShared(const Archetype* Arch) const
+{
+    return static_cast<const S*>(SharedValues.Find(Arch->SharedSet, GetComponentTypeID<S>()));
+}
+
+template <typename Fn>
+void Registry::ForEachPhaseRange(Archetype* Arch, UpdateFunc EntityMeta::* Phase, Fn&& Visit)
+{
+    MetaRegistry& MR = MetaRegistry::Get();
+    if (Arch->bDormant)
+        return;
+
+    if (!Arch->bMergedClasses)
+    {
+        UpdateFunc Kernel = MR.EntityGetters[Arch->ArchClassID].*Phase;
+        if (!Kernel)
+            return;
+
+        // Whole chunks, so blocked archetypes start every call on a block
+        for (uint32_t chunkIdx = 0; chunkIdx < Arch->Chunks.size(); ++chunkIdx)
+        {
+            const uint32_t entityCount = Arch->GetChunkCount(chunkIdx);
+            if (entityCount > 0)
+                Visit(chunkIdx, Arch->GetChunkFirstRow(chunkIdx), Arch->GetKernelCount(entityCount), Kernel);
+        }
+        return;
+    }
+
+    for (const Archetype::ClassRun& Run : Arch->ClassRuns)
+    {
+        UpdateFunc Kernel = MR.EntityGetters[Run.ID].*Phase;
+        if (!Kernel)
+            continue;
+
+        // Runs can straddle chunks, each chunk slice is one kernel call
+        for (uint32_t Row = Run.FirstRow, EndRow = Run.FirstRow + Run.Count; Row < EndRow;)
+        {
+            const uint32_t LocalRow = Row % Arch->EntitiesPerChunk;
+            const uint32_t Count = std::min(EndRow - Row, Arch->EntitiesPerChunk - LocalRow);
+            Visit(Row / Arch->EntitiesPerChunk, LocalRow, Count, Kernel);
+            Row += Count;
+        }
+    }
+}
+
+inline void Registry::InvokeUpdate(double dt)
 {
     STRIGID_ZONE_C(STRIGID_COLOR_LOGIC);
 
     constexpr size_t MAX_FIELD_ARRAYS = 64; // Max total fields across all components in archetype
     void* fieldArrayTable[MAX_FIELD_ARRAYS];
 
+    SortClassRuns();
     for (auto& [sig, arch] : Archetypes)
     {
-        UpdateFunc PostPhys = MetaRegistry::Get().EntityGetters[sig.ID].PostPhys;
-        if (!PostPhys)
-            continue;
+        ForEachPhaseRange(arch, &EntityMeta::Update, [&](uint32_t chunkIdx, uint32_t firstRow, uint32_t entityCount,
+                                                         UpdateFunc Update)
+        {
+            // Build field array table on stack (fast!)
+            // For CubeEntity (Transform + Velocity): 12 + 4 = 16 entries
+            arch->MarkChanged(arch->Chunks[chunkIdx]);
+            arch->BuildFieldArrayTable(arch->Chunks[chunkIdx], fieldArrayTable, firstRow);
+
+            // Invoke batch processor with field array table
+            Update(this, dt, fieldArrayTable, entityCount);
+        });
+    }
+
+    FlushCommandBuffers();
+}
 
-        size_t size = arch->Chunks.size();
-        for (size_t chunkIdx = 0; chunkIdx < size; ++chunkIdx)
+inline void Registry::InvokePrePhys(double dt)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_LOGIC);
+
+    // Flatten to one job per chunk so chunks can be routed to workers on their NUMA node
+    PhaseJobs.clear();
+    PhaseJobNodes.clear();
+
+    SortClassRuns();
+    for (auto& [sig, arch] : Archetypes)
+    {
+        ForEachPhaseRange(arch, &EntityMeta::PrePhys, [&](uint32_t chunkIdx, uint32_t firstRow, uint32_t entityCount,
+                                                          UpdateFunc prePhys)
         {
-            Chunk* chunk = arch->Chunks[chunkIdx];
-            uint32_t entityCount = arch->GetChunkCount(chunkIdx);
+            PhaseJobs.push_back({arch, chunkIdx, firstRow, entityCount, prePhys});
+            PhaseJobNodes.push_back(static_cast<uint8_t>(arch->Chunks[chunkIdx]->GetHeader().NumaNode));
+        });
+    }
 
-            if (entityCount == 0)
-                continue;
+    // Commands recorded by the jobs get their own phase, ordered after anything recorded before
+    ++CommandPhase;
+    [[maybe_unused]] JobBatchStats Stats = JobSystem::Get().ParallelFor(static_cast<uint32_t>(PhaseJobs.size()), [&](uint32_t JobIndex)
+    {
+        constexpr size_t MAX_FIELD_ARRAYS = 64; // Max total fields across all components in archetype
+        void* fieldArrayTable[MAX_FIELD_ARRAYS];
 
+        const ChunkJob& Job = PhaseJobs[JobIndex];
+        Archetype* arch = Job.Arch;
+
+        // Build field array table on stack (fast!)
+        arch->MarkChanged(arch->Chunks[Job.ChunkIndex]);
+        arch->BuildFieldArrayTable(arch->Chunks[Job.ChunkIndex], fieldArrayTable, Job.FirstRow);
+
+        // Invoke batch processor with field array table
+        Job.Func(this, dt, fieldArrayTable, Job.Count);
+    }, PhaseJobNodes.data());
+    ++CommandPhase;
+
+    STRIGID_PLOT("PrePhysics Remote Chunks", static_cast<int64_t>(Stats.RemoteJobs));
+
+    FlushCommandBuffers();
+}
+
+inline void Registry::InvokePostPhys(double dt)
+{
+    STRIGID_ZONE_C(STRIGID_COLOR_LOGIC);
+
+    constexpr size_t MAX_FIELD_ARRAYS = 64; // Max total fields across all components in archetype
+    void* fieldArrayTable[MAX_FIELD_ARRAYS];
+
+    SortClassRuns();
+    for (auto& [sig, arch] : Archetypes)
+    {
+        ForEachPhaseRange(arch, &EntityMeta::PostPhys, [&](uint32_t chunkIdx, uint32_t firstRow,
+                                                           uint32_t entityCount, UpdateFunc PostPhys)
+        {
             // Build field array table on stack (fast!)
             // For CubeEntity (Transform + Velocity): 12 + 4 = 16 entries
-            arch->BuildFieldArrayTable(chunk, fieldArrayTable);
+            arch->MarkChanged(arch->Chunks[chunkIdx]);
+            arch->BuildFieldArrayTable(arch->Chunks[chunkIdx], fieldArrayTable, firstRow);
 
             // Invoke batch processor with field array table
-            PostPhys(dt, fieldArrayTable, entityCount);
-        }
+            PostPhys(this, dt, fieldArrayTable, entityCount);
+        });
     }
+
+    // A fixed tick ends here: transient rows spawned by it are marked and expired ones dropped, due timers fire
+    // and value indexes catch up with the chunks written during it
+    FlushCommandBuffers();
+    ExpireTransients();
+    FireTimers();
+    UpdateIndexes();
 }
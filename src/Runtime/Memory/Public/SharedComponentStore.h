@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "Types.h"
+
+/**
+ * SharedComponentStore: interned values of shared (per-chunk) components
+ *
+ * A shared component value is stored once no matter how many entities use it. Identical bytes
+ * intern to the same value handle, and the combination of shared values an entity has (one per
+ * shared component type) interns to a set index. The set index is part of the archetype key, so
+ * every distinct combination gets its own chunks, and every chunk header names its set.
+ *
+ * Value handle 0 and set 0 are reserved for "none". Interning is thread-safe, so values can be
+ * recorded from parallel kernels; sets are only built at the sync point.
+ */
+class SharedComponentStore
+{
+public:
+    SharedComponentStore();
+
+    // Handle of a value of component TypeID, creating it if these bytes haven't been seen before
+    uint32_t InternValue(ComponentTypeID TypeID, const void* Data, size_t Size);
+
+    // Set equal to SetIndex with the value for ValueHandle's component type replaced (or added)
+    uint32_t WithValue(uint32_t SetIndex, uint32_t ValueHandle);
+
+    // Set equal to SetIndex without a value for TypeID
+    uint32_t WithoutType(uint32_t SetIndex, ComponentTypeID TypeID);
+
+    // Value of TypeID in a set, nullptr if the set has none
+    const void* Find(uint32_t SetIndex, ComponentTypeID TypeID) const;
+
+    // Value handle of TypeID in a set, 0 if the set has none (handles order groups of equal values)
+    uint32_t FindHandle(uint32_t SetIndex, ComponentTypeID TypeID) const;
+
+    ComponentTypeID GetValueType(uint32_t ValueHandle) const;
+
+private:
+    struct SharedValue
+    {
+        ComponentTypeID TypeID;
+        std::string Bytes;
+    };
+
+    // Intern a sorted value handle list (lock held)
+    uint32_t InternSet(std::vector<uint32_t>&& Handles);
+
+    mutable std::shared_mutex Mutex;
+
+    // deques keep references stable while other threads intern
+    std::deque<SharedValue> Values;
+    std::map<std::pair<ComponentTypeID, std::string>, uint32_t> ValueLookup;
+
+    // Each set holds value handles sorted by component type
+    std::deque<std::vector<uint32_t>> Sets;
+    std::map<std::vector<uint32_t>, uint32_t> SetLookup;
+};
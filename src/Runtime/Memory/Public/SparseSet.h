@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Types.h"
+
+/**
+ * SparseSet: alternative storage for rarely-attached or frequently-toggled components
+ *
+ * Values live in a dense packed array next to the ID that owns them, found through a paged sparse
+ * map indexed by EntityID.GetIndex(). Attaching or detaching never touches the entity's archetype,
+ * so toggling a buff doesn't move the entity's row or create another archetype.
+ * Removal swaps the last element into the hole, so the dense array stays packed for iteration.
+ *
+ * Type-erased (element size only); Registry wraps it with typed accessors. Not thread-safe.
+ */
+class SparseSet
+{
+public:
+    static constexpr uint32_t PAGE_SHIFT = 12;
+    static constexpr uint32_t PAGE_SIZE = 1u << PAGE_SHIFT;
+
+    SparseSet(ComponentTypeID InTypeID, size_t InElementSize);
+
+    // Value of Id, nullptr if Id (this generation) doesn't have one
+    void* Find(EntityID Id);
+
+    // Insert a zeroed value for Id (or return the existing one)
+    void* Emplace(EntityID Id);
+
+    // Returns false if Id had no value
+    bool Remove(EntityID Id);
+
+    void Clear();
+
+    uint32_t Size() const { return static_cast<uint32_t>(DenseIds.size()); }
+    ComponentTypeID GetTypeID() const { return TypeID; }
+    size_t GetElementSize() const { return ElementSize; }
+
+    // Dense arrays, element i belongs to GetDenseIDs()[i]
+    const EntityID* GetDenseIDs() const { return DenseIds.data(); }
+    void* GetDenseValue(uint32_t DenseIndex) { return DenseValues.data() + static_cast<size_t>(DenseIndex) * ElementSize; }
+
+private:
+    // Sparse slot for an index, allocating the page if bAllocate (entries are dense index + 1, 0 = absent)
+    uint32_t* SparseSlot(uint32_t Index, bool bAllocate);
+
+    ComponentTypeID TypeID;
+    size_t ElementSize;
+
+    std::vector<std::unique_ptr<uint32_t[]>> SparsePages;
+    std::vector<EntityID> DenseIds;
+    std::vector<uint8_t> DenseValues;
+};
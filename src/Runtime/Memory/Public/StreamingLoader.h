@@ -0,0 +1,73 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class Registry;
+
+// Region file layout (written by Registry::SaveRegion):
+// RegionFileHeader, then BatchCount x [RegionBatchHeader, FieldArrayCount x uint32 element size,
+// then every field array's RowCount elements back to back, in the class archetype's field array order].
+// ClassIDs and layouts are those of the build that wrote the file, StageRegion rejects batches that don't match.
+struct RegionFileHeader
+{
+    static constexpr uint32_t MAGIC = 0x4E475253; // "SRGN"
+    static constexpr uint32_t VERSION = 1;
+
+    uint32_t Magic = MAGIC;
+    uint32_t Version = VERSION;
+    uint32_t BatchCount = 0;
+    uint32_t Reserved = 0;
+};
+
+struct RegionBatchHeader
+{
+    uint32_t ClassID;
+    uint32_t RowCount;
+    uint32_t FieldArrayCount;
+};
+
+/**
+ * StreamingLoader: background loading of region files into a Registry
+ *
+ * Requested files are read and decoded on the loader's own thread (Registry::StageRegion), into staging
+ * chunks that already hold every row and have their EntityRecords built. The logic thread only splices
+ * those chunks into the live archetypes at its next sync point, so streaming in a region never creates
+ * or initializes entities inline.
+ *
+ * Must be destroyed before the Registry it feeds. Requests still queued at destruction are dropped.
+ */
+class StreamingLoader
+{
+public:
+    explicit StreamingLoader(Registry& InTarget);
+    ~StreamingLoader();
+
+    StreamingLoader(const StreamingLoader&) = delete;
+    StreamingLoader& operator=(const StreamingLoader&) = delete;
+
+    // Queue a region file, any thread
+    void Request(const std::string& Path);
+
+    // Block until every request so far is staged (it joins the world at the next sync point)
+    void WaitIdle();
+
+    // Requests not staged yet
+    uint32_t GetQueuedCount() const;
+
+private:
+    void LoaderMain();
+
+    Registry& Target;
+    std::thread Loader;
+
+    mutable std::mutex Mutex;
+    std::condition_variable QueueCondition;
+    std::condition_variable IdleCondition;
+    std::deque<std::string> Queue;
+    bool bBusy = false;
+    bool bStop = false;
+};
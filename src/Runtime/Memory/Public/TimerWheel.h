@@ -0,0 +1,85 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Types.h"
+
+// Returned by Registry::ScheduleTimer, stays unique after the timer fired or was cancelled
+struct TimerHandle
+{
+    uint32_t Index = 0;
+    uint32_t Generation = 0; // 0 = invalid
+
+    bool IsValid() const { return Generation != 0; }
+};
+
+// One due timer, as handed to TimerWheel::Advance's caller
+struct TimerExpiry
+{
+    EntityID Id;
+    uint64_t Payload;
+    uint32_t CallbackID;
+};
+
+/**
+ * TimerWheel: hierarchical timing wheel keyed by fixed-step tick
+ *
+ * Four levels of 256 slots cover the whole 32-bit tick range. A timer sits in the level whose span
+ * covers its remaining delay and moves down one level each time the level above turns over, so it is
+ * touched at most four times over its life. Entries are pooled and linked into their slot by index,
+ * which makes insert and cancel O(1) and expiry O(1) amortized. Stale handles are told apart by a
+ * per-entry generation.
+ *
+ * Stores (EntityID, callback id, payload) only, Registry resolves and dispatches what expires.
+ * Not thread-safe.
+ */
+class TimerWheel
+{
+public:
+    static constexpr uint32_t LEVELS = 4;
+    static constexpr uint32_t SLOT_BITS = 8;
+    static constexpr uint32_t SLOTS = 1u << SLOT_BITS;
+
+    TimerWheel();
+
+    // Due DelayTicks after the current tick (at least 1)
+    TimerHandle Insert(EntityID Id, uint32_t DelayTicks, uint32_t CallbackID, uint64_t Payload);
+
+    // False if the timer already fired or was cancelled
+    bool Cancel(TimerHandle Handle);
+
+    // Step to the next tick and append every timer due on it to OutExpired
+    void Advance(std::vector<TimerExpiry>& OutExpired);
+
+    // Drop every timer, the tick is kept
+    void Clear();
+
+    uint32_t GetTick() const { return Now; }
+    uint32_t GetPendingCount() const { return PendingCount; }
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Entry
+    {
+        EntityID Id;
+        uint64_t Payload;
+        uint32_t CallbackID;
+        uint32_t Due;
+        uint32_t Next;
+        uint32_t Prev;
+        uint32_t Generation;
+        uint32_t Bucket; // Level * SLOTS + slot, NIL while free
+    };
+
+    // Link an entry into the slot for its due tick
+    void Schedule(uint32_t EntryIndex);
+    void Unlink(uint32_t EntryIndex);
+    void Release(uint32_t EntryIndex);
+
+    std::vector<Entry> Entries;
+    uint32_t FreeHead = NIL;
+    uint32_t Buckets[LEVELS * SLOTS];
+    uint32_t Now = 0;
+    uint32_t PendingCount = 0;
+};
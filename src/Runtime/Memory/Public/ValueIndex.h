@@ -0,0 +1,98 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Types.h"
+
+enum class ValueIndexKind : uint8_t
+{
+    Ordered, // Sorted array, range and equality lookups
+    Hash // Hash buckets, equality lookups only
+};
+
+/**
+ * ValueIndex: secondary index from a field value to the entities holding it
+ *
+ * Keys are the field values widened to double (exact for float and 32-bit integer fields). Updates come in
+ * batches from Registry::UpdateIndexes: an ordered index merges the sorted batch into its array in one pass,
+ * a hash index touches only the buckets of changed keys. Lookups return IDs in key order (ordered) or in
+ * no particular order (hash).
+ *
+ * Stores (Key, EntityID) pairs only, Registry resolves them to rows. Not thread-safe.
+ */
+class ValueIndex
+{
+public:
+    struct Entry
+    {
+        double Key;
+        EntityID Id;
+
+        bool operator<(const Entry& Other) const
+        {
+            return Key != Other.Key ? Key < Other.Key : Id.Value < Other.Id.Value;
+        }
+        bool operator==(const Entry& Other) const { return Key == Other.Key && Id == Other.Id; }
+    };
+
+    explicit ValueIndex(ValueIndexKind InKind) : Kind(InKind) {}
+
+    // Apply one maintenance step, every removed entry must be in the index. Both batches are consumed
+    void Apply(std::vector<Entry>& Removed, std::vector<Entry>& Added);
+
+    // Visit(EntityID) for every entry with Min <= Key <= Max, ordered indexes only
+    template <typename Fn>
+    void VisitRange(double Min, double Max, Fn&& Visit) const;
+
+    // Visit(EntityID) for every entry with Key == Value
+    template <typename Fn>
+    void VisitEqual(double Value, Fn&& Visit) const;
+
+    void Clear();
+
+    ValueIndexKind GetKind() const { return Kind; }
+    size_t GetSize() const { return Size; }
+
+private:
+    ValueIndexKind Kind;
+    size_t Size = 0;
+
+    // Ordered: every entry, by (Key, Id)
+    std::vector<Entry> Sorted;
+    std::vector<Entry> MergeScratch;
+
+    // Hash: key -> IDs, unordered
+    std::unordered_map<double, std::vector<EntityID>> Buckets;
+};
+
+template <typename Fn>
+void ValueIndex::VisitRange(double Min, double Max, Fn&& Visit) const
+{
+    auto It = std::lower_bound(Sorted.begin(), Sorted.end(), Min,
+                               [](const Entry& E, double Key) { return E.Key < Key; });
+    for (; It != Sorted.end() && It->Key <= Max; ++It)
+    {
+        Visit(It->Id);
+    }
+}
+
+template <typename Fn>
+void ValueIndex::VisitEqual(double Value, Fn&& Visit) const
+{
+    if (Kind == ValueIndexKind::Ordered)
+    {
+        VisitRange(Value, Value, Visit);
+        return;
+    }
+
+    auto Found = Buckets.find(Value);
+    if (Found == Buckets.end())
+        return;
+
+    for (EntityID Id : Found->second)
+    {
+        Visit(Id);
+    }
+}
@@ -13,6 +13,7 @@
 #include "Profiler.h"
 #include "Registry.h"
 #include "Transform.h"
+#include "WorldSector.h"
 
 void RenderThread::Initialize(Registry* registry, LogicThread* logic, const EngineConfig* config, SDL_GPUDevice* device,
                               SDL_Window* window)
@@ -247,6 +248,10 @@ void RenderThread::SnapshotSparseArrays(std::shared_ptr<FramePacket> packet)
         if (!arch) [[unlikely]]
             break;
 
+        // Sectored archetypes store positions as offsets, keep the sector so interpolation can rebase them
+        const WorldSector* sector = RegistryPtr->GetShared<WorldSector>(arch);
+        const WorldSector archSector = sector ? *sector : WorldSector{0, 0, 0};
+
         for (size_t chunkIdx = 0; chunkIdx < arch->Chunks.size(); ++chunkIdx)
         {
             Chunk* chunk = arch->Chunks[chunkIdx];
@@ -256,7 +261,7 @@ void RenderThread::SnapshotSparseArrays(std::shared_ptr<FramePacket> packet)
                 continue;
 
             // Build field array table
-            arch->BuildFieldArrayTable(chunk, fieldArrayTable);
+            arch->BuildFieldArrayTable(chunk, fieldArrayTable, arch->GetChunkFirstRow(chunkIdx));
 
             // Get Transform field arrays (indices 0-11)
             auto posXArray = static_cast<float*>(fieldArrayTable[0]);
@@ -281,9 +286,10 @@ void RenderThread::SnapshotSparseArrays(std::shared_ptr<FramePacket> packet)
             auto aArray = static_cast<float*>(fieldArrayTable[12]);
 
             // Copy data to snapshot
-            for (uint32_t i = 0; i < chunkEntityCount; ++i)
+            for (uint32_t row = 0; row < chunkEntityCount; ++row)
             {
                 SnapshotEntry& entry = SnapshotCurrent[writeIdx++];
+                const uint32_t i = arch->GetElementIndex(row, sizeof(float)); // Blocked archetypes interleave fields
 
                 // Copy transform data
                 entry.PositionX = posXArray[i];
@@ -295,6 +301,9 @@ void RenderThread::SnapshotSparseArrays(std::shared_ptr<FramePacket> packet)
                 entry.ScaleX = scaleXArray[i];
                 entry.ScaleY = scaleYArray[i];
                 entry.ScaleZ = scaleZArray[i];
+                entry.SectorX = archSector.X;
+                entry.SectorY = archSector.Y;
+                entry.SectorZ = archSector.Z;
 
                 // Copy color data
                 entry.ColorR = rArray[i];
@@ -364,6 +373,14 @@ bool RenderThread::InterpolateToTransferBuffer(float alpha)
 
     auto instances = static_cast<InstanceData*>(mapped);
 
+    // Positions are offsets within their WorldSector, rebase both snapshots to camera-relative floats before the
+    // lerp (sector deltas are small integers near the camera, so this keeps full float precision where it matters)
+    const ViewState& view = CurrentFramePacket->View;
+    auto Rebase = [](int32_t Sector, int32_t CameraSector, float Offset)
+    {
+        return static_cast<float>(Sector - CameraSector) * WorldSector::SIZE + Offset;
+    };
+
     // Interpolate between SnapshotPrevious and SnapshotCurrent
     for (size_t i = 0; i < entityCount; ++i)
     {
@@ -371,9 +388,12 @@ bool RenderThread::InterpolateToTransferBuffer(float alpha)
         const SnapshotEntry& curr = SnapshotCurrent[i];
 
         // Lerp position
-        instances[i].PositionX = prev.PositionX + (curr.PositionX - prev.PositionX) * alpha;
-        instances[i].PositionY = prev.PositionY + (curr.PositionY - prev.PositionY) * alpha;
-        instances[i].PositionZ = prev.PositionZ + (curr.PositionZ - prev.PositionZ) * alpha;
+        const float prevX = Rebase(prev.SectorX, view.SectorX, prev.PositionX);
+        const float prevY = Rebase(prev.SectorY, view.SectorY, prev.PositionY);
+        const float prevZ = Rebase(prev.SectorZ, view.SectorZ, prev.PositionZ);
+        instances[i].PositionX = prevX + (Rebase(curr.SectorX, view.SectorX, curr.PositionX) - prevX) * alpha;
+        instances[i].PositionY = prevY + (Rebase(curr.SectorY, view.SectorY, curr.PositionY) - prevY) * alpha;
+        instances[i].PositionZ = prevZ + (Rebase(curr.SectorZ, view.SectorZ, curr.PositionZ) - prevZ) * alpha;
 
         // Lerp rotation
         instances[i].RotationX = prev.RotationX + (curr.RotationX - prev.RotationX) * alpha;
@@ -13,7 +13,7 @@ struct alignas(16) SnapshotEntry
     float PositionX, PositionY, PositionZ;
     float RotationX, RotationY, RotationZ;
     float ScaleX, ScaleY, ScaleZ;
-    float _pad0, _pad1, _pad2; // Padding to 48 bytes
+    int32_t SectorX, SectorY, SectorZ; // WorldSector of the row's chunk (0 without one), pads to 48 bytes
 
     // ColorData (16 bytes)
     float ColorR, ColorG, ColorB, ColorA;